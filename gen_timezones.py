@@ -0,0 +1,62 @@
+# Generates src/timezone_data.cpp from the IANA timezone database installed
+# with Python (zoneinfo, from tzdata or the system's /usr/share/zoneinfo).
+# Each zone's POSIX TZ string is the footer of its TZif file; it describes
+# the zone from now on, though not the one-off changes that some zones
+# (e.g. Morocco during Ramadan) only have in the transition table.
+#
+#   python gen_timezones.py
+import zoneinfo
+from importlib import resources
+
+OUTPUT = "src/timezone_data.cpp"
+
+
+def tz_string(name):
+    try:
+        data = open("/usr/share/zoneinfo/" + name, "rb").read()
+    except OSError:
+        data = resources.files("tzdata.zoneinfo").joinpath(name).read_bytes()
+    return data.rstrip(b"\n").rsplit(b"\n", 1)[-1].decode()
+
+
+names = sorted(n for n in zoneinfo.available_timezones()
+               if "/" in n and not n.startswith(("posix/", "right/")))
+rules = sorted({tz_string(n) for n in names})
+assert len(rules) < 256
+
+# names that continue the previous one's region are written as "/City"
+packed = []
+region = None
+for name in names:
+    head, tail = name.split("/", 1)
+    packed.append("/" + tail if head == region else name)
+    region = head
+
+# Timezones::MAX_NAME_LENGTH and MAX_RULE_LENGTH
+assert max(map(len, names)) <= 63 and max(map(len, rules)) <= 63
+
+with open(OUTPUT, "w") as out:
+    out.write("// Generated by gen_timezones.py -- don't edit\n")
+    out.write("#include <timezones.hpp>\n\n")
+    out.write("const int Timezones::COUNT = %d;\n\n" % len(names))
+    out.write("const char Timezones::NAMES[] PROGMEM =\n")
+    line = '    "'
+    for name in packed:
+        if len(line) + len(name) > 77:
+            out.write(line + '"\n')
+            line = '    "'
+        line += name + " "
+    out.write(line.rstrip() + '";\n\n')
+
+    out.write("const char Timezones::RULES[] PROGMEM =\n")
+    for rule in rules:
+        out.write('    "%s\\0"\n' % rule)
+    out.write("    ;\n\n")
+
+    out.write("const uint8_t Timezones::ZONE_RULES[] PROGMEM = {\n")
+    indexes = [str(rules.index(tz_string(n))) for n in names]
+    for i in range(0, len(indexes), 16):
+        out.write("    " + ", ".join(indexes[i:i + 16]) + ",\n")
+    out.write("};\n")
+
+print("%d zones, %d rules -> %s" % (len(names), len(rules), OUTPUT))
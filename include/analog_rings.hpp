@@ -0,0 +1,46 @@
+#pragma once
+#include <pixels.hpp>
+
+#if FCOS_CARDCLOCK || FCOS_CARDCLOCK2
+// Draws the hour, minute and second hands on the round LEDs with continuous
+// (sub-LED) positions. A hand between two LEDs is spread across both of them,
+// and the second hand also sweeps across the rings once per second. All of the
+// weights come from tables that are built at compile time, so drawing a hand
+// costs a few table reads and a handful of Set() calls. The rings come from
+// Geometry, like BasicPixels; AnalogRings is the one for this build.
+template <typename Geometry>
+class BasicAnalogRings {
+  public:
+    enum {
+        POS_PER_LED = 256,  // hand positions are in 1/256ths of an LED
+        POS_PER_RING = Geometry::RING_SIZE * POS_PER_LED,
+        SUBSECOND_STEPS = 32,
+        MIN_WEIGHT = 8,  // anything dimmer leaves the ring background alone
+    };
+
+    using RingWeights = uint8_t[Geometry::NUM_RINGS];
+
+    static void DrawHands(BasicPixels<Geometry>& pixels,
+                          const int hour12,
+                          const int minute,
+                          const int second,
+                          const int millis,
+                          const RgbColor hourColor,
+                          const RgbColor minuteColor,
+                          const RgbColor secondColor);
+
+    // pos: 0 is the 1:00 LED (same as Pixels::DrawRingLED), wraps at
+    // POS_PER_RING. ringWeights: 0-255 per ring, 0 leaves that ring untouched
+    static void DrawHand(BasicPixels<Geometry>& pixels,
+                         const uint32_t pos,
+                         const RgbColor color,
+                         const RingWeights& ringWeights);
+
+    // positions of each hand, 12:00 is POS_PER_RING - POS_PER_LED
+    static uint32_t GetHourPos(const int hour12, const int minute);
+    static uint32_t GetMinutePos(const int minute, const int second);
+    static uint32_t GetSecondPos(const int second, const int millis);
+};
+
+using AnalogRings = BasicAnalogRings<ActiveGeometry>;
+#endif
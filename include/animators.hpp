@@ -2,10 +2,55 @@
 #include <functional>
 
 #include <elapsed_time.hpp>
+#include <life_board.hpp>
 #include <pixels.hpp>
 #include <rtc.hpp>
+#include <shaders.hpp>
+
+// The colors the Clock draws the digits, colon and hands with
+struct DigitColorSource {
+    virtual ~DigitColorSource() {}
+
+    // picks the next colors, when it's time to
+    virtual void UpdateColors() = 0;
+
+    // whether the colors change by themselves, rather than only on input
+    virtual bool AreColorsAnimating() const = 0;
+
+    virtual RgbColor GetDigitColor(size_t index) = 0;
+    virtual RgbColor GetColonColor() = 0;
+    // with the per digit and colon brightness applied
+    virtual RgbColor GetAdjustedDigitColor(size_t index) = 0;
+    virtual RgbColor GetAdjustedDigitColorEnd(size_t index) = 0;
+    virtual RgbColor GetAdjustedColonColor() = 0;
+    virtual RgbColor GetAdjustedColonColorEnd() = 0;
+};
+
+// What the Clock draws behind the digits
+struct BackgroundEffect {
+    virtual ~BackgroundEffect() {}
+
+    virtual void Start() = 0;
+
+    // draws the next frame, when it's time to
+    virtual void DrawBackground() = 0;
+
+    virtual bool IsBackgroundAnimating() const = 0;
+
+    virtual void SetBackgroundColor(uint8_t colorWheelPos) = 0;
+
+    virtual const String& GetName() const = 0;
+};
+
+// An Animator is both, and the Clock can take them from different Animators
+// (see the BG setting):
+//  - func, every freq ms, picks the colors the Clock draws the digits with
+//  - draw, every drawFreq ms, draws the background behind the digits
+// Most animators' colors and backgrounds share their state (e.g. the wheel
+// position), so one struct implements the two interfaces.
+struct Animator : public DigitColorSource, public BackgroundEffect {
+    using Geometry = Pixels::Shape;
 
-struct Animator {
     std::shared_ptr<Pixels> pixels;
     std::shared_ptr<Settings> settings;
     std::shared_ptr<Rtc> rtc;
@@ -20,24 +65,51 @@ struct Animator {
     uint8_t wheelPos{0};
     size_t freq{0};  // ms
     std::function<void(Animator& a)> func;
+    ElapsedTime sinceLastDraw;
+    size_t drawFreq{0};  // ms
+    std::function<void(Animator& a)> draw;
     String name;
+    // func picks the same colors every time until there's input
+    bool hasFixedColors{false};
 
     Animator();
 
+    // both parts, for when this Animator is the only one running
     void Update();
 
-    virtual void Start();
+    virtual void UpdateColors() override;
+
+    virtual void DrawBackground() override;
+
+    virtual bool AreColorsAnimating() const override {
+        return freq > 0 && func && !hasFixedColors;
+    }
+
+    virtual bool IsBackgroundAnimating() const override {
+        return drawFreq > 0 && draw;
+    }
+
+    virtual void Start() override;
 
     virtual void SetColor(uint8_t colorWheelPos);
 
-    virtual RgbColor GetColonColor();
+    virtual void SetBackgroundColor(uint8_t colorWheelPos) override {
+        wheelPos = colorWheelPos;
+    }
+
+    virtual const String& GetName() const override { return name; }
+
+    virtual RgbColor GetDigitColor(size_t index) override {
+        return digitColors[index];
+    }
+    virtual RgbColor GetColonColor() override;
     virtual RgbColor GetColonColorEnd();
     
     // New methods for brightness-adjusted colors
-    RgbColor GetAdjustedDigitColor(size_t index);
-    RgbColor GetAdjustedDigitColorEnd(size_t index);
-    RgbColor GetAdjustedColonColor();
-    RgbColor GetAdjustedColonColorEnd();
+    virtual RgbColor GetAdjustedDigitColor(size_t index) override;
+    virtual RgbColor GetAdjustedDigitColorEnd(size_t index) override;
+    virtual RgbColor GetAdjustedColonColor() override;
+    virtual RgbColor GetAdjustedColonColorEnd() override;
     
     // Methods to control brightness
     virtual void SetDigitBrightness(size_t index, float brightness);
@@ -148,7 +220,7 @@ struct IndividualDigitColors : public Animator {
 
 struct RainbowFixedMatrix : public Animator {
     struct MatrixDot {
-        int8_t x{-1}, y{DISPLAY_HEIGHT};
+        int8_t x{-1}, y{Geometry::HEIGHT};
         RgbColor color{BLACK};
         ElapsedTime time;
         float period{0};  // ms
@@ -183,8 +255,8 @@ struct Starfield : public Animator {
         
         void Reset() {
             // Start at center of display
-            x = DISPLAY_WIDTH / 2.0f;
-            y = DISPLAY_HEIGHT / 2.0f;
+            x = Geometry::WIDTH / 2.0f;
+            y = Geometry::HEIGHT / 2.0f;
             
             // Random direction vector (but not zero)
             do {
@@ -220,11 +292,17 @@ struct Starfield : public Animator {
         
         // Check if star is out of bounds
         bool IsOutOfBounds() {
-            return x < 0 || x >= DISPLAY_WIDTH || y < 0 || y >= DISPLAY_HEIGHT;
+            return x < 0 || x >= Geometry::WIDTH || y < 0 ||
+                   y >= Geometry::HEIGHT;
         }
     };
     
+    enum {
+        TRAIL_HALF_LIFE_MS = 140,
+    };
+
     std::vector<Star> stars;
+    Pixels::Layer trail;
     
     Starfield();
     
@@ -246,7 +324,7 @@ struct SnowfallAnimator : public Animator {
         
         void Reset() {
             // Start at random position at the top
-            x = (float)(rand() % DISPLAY_WIDTH);
+            x = (float)(rand() % Geometry::WIDTH);
             y = 0;
             
             // Random horizontal drift
@@ -271,15 +349,15 @@ struct SnowfallAnimator : public Animator {
             
             // Wrap around horizontally if blown off-screen
             if (x < 0) {
-                x = DISPLAY_WIDTH - 1;
-            } else if (x >= DISPLAY_WIDTH) {
+                x = Geometry::WIDTH - 1;
+            } else if (x >= Geometry::WIDTH) {
                 x = 0;
             }
         }
         
         // Check if snowflake has reached the bottom
         bool HasReachedBottom() {
-            return y >= DISPLAY_HEIGHT;
+            return y >= Geometry::HEIGHT;
         }
     };
     
@@ -295,7 +373,7 @@ struct SnowfallAnimator : public Animator {
         }
         
         void Reset() {
-            x = rand() % DISPLAY_WIDTH;
+            x = rand() % Geometry::WIDTH;
             height = 1;
             meltDelay = 5000 + (rand() % 5000);  // 5-10 seconds
             meltTimer.Reset();
@@ -308,7 +386,11 @@ struct SnowfallAnimator : public Animator {
     
     std::vector<Snowflake> snowflakes;
     std::vector<SnowPile> snowPiles;
-    std::vector<RgbColor> displayBuffer;  // Buffer to store current display state
+    enum {
+        TRAIL_HALF_LIFE_MS = 85,
+    };
+
+    Pixels::Layer trail;  // flakes, their trails and the snow piles
     
     ElapsedTime windChangeTimer;
     int windChangeDuration{0};
@@ -328,6 +410,75 @@ struct SnowfallAnimator : public Animator {
     // Helper method to calculate snow color based on brightness and color position
     RgbColor CalculateSnowColor(float brightness);
 };
+
+// Fills the matrix behind the digits with a Shader (see shaders.hpp) every
+// frame. Up/Down change the hue as usual, Left/Right the intensity.
+template <typename Shader>
+struct ShaderAnimator : public Animator {
+    enum {
+        LEVEL_STEP = 16,
+        LEVEL_MIN = 16,
+        LEVEL_MAX = 96,
+    };
+
+    Shader shader;
+    ShaderParams params;
+
+    ShaderAnimator(const char* shaderName) : Animator() {
+        name = shaderName;
+    }
+
+    virtual void Start() override {
+        Animator::Start();
+        if (!(*settings).containsKey("SHADER_LVL")) {
+            (*settings)["SHADER_LVL"] = params.level;
+        }
+        params.level = (*settings)["SHADER_LVL"].as<uint8_t>();
+
+        drawFreq = 1;  // every frame, since the Clock darkens the matrix
+        draw = [this](Animator& a) {
+            params.hue = wheelPos;
+            pixels->Shade(shader, millis(), params);
+        };
+    }
+
+    virtual bool Left() override { return SetLevel(params.level - LEVEL_STEP); }
+
+    virtual bool Right() override {
+        return SetLevel(params.level + LEVEL_STEP);
+    }
+
+  private:
+    bool SetLevel(const int level) {
+        params.level = std::max<int>(LEVEL_MIN, std::min<int>(LEVEL_MAX, level));
+        (*settings)["SHADER_LVL"] = params.level;
+        return true;
+    }
+};
+
+// Conway's Game of Life in the background, reseeded when it settles down
+struct GameOfLife : public Animator {
+    enum {
+        GENERATION_MS = 400,
+        MAX_GENERATIONS = 300,  // reseed eventually, even if it never settles
+        SEED_PERCENT = 35,
+        CELL_LEVEL = 64,
+        DEATH_HALF_LIFE_MS = 150,  // how quickly cells that died fade out
+    };
+
+    using Board = LifeBoard<Geometry::WIDTH, Geometry::HEIGHT>;
+    Board board, previous, older;
+    Pixels::Layer cells;
+    ElapsedTime sinceGeneration;
+    size_t generations{0};
+
+    GameOfLife();
+
+    virtual void Start() override;
+
+    void Seed();
+    void Step();
+};
 #endif
 
 enum AnimatorType_e {
@@ -344,6 +495,10 @@ enum AnimatorType_e {
     ANIM_HOLIDAY_LIGHTS,
     ANIM_STARFIELD,
     ANIM_SNOWFALL,
+    ANIM_PLASMA,
+    ANIM_GRADIENT,
+    ANIM_NOISE,
+    ANIM_LIFE,
 #endif
     ANIM_TOTAL,
 };
@@ -393,6 +548,18 @@ static inline std::shared_ptr<Animator> CreateAnimator(
         case ANIM_SNOWFALL:
             anim = std::make_shared<SnowfallAnimator>();
             break;
+        case ANIM_PLASMA:
+            anim = std::make_shared<ShaderAnimator<PlasmaShader>>("Plasma");
+            break;
+        case ANIM_GRADIENT:
+            anim = std::make_shared<ShaderAnimator<GradientShader>>("Gradient");
+            break;
+        case ANIM_NOISE:
+            anim = std::make_shared<ShaderAnimator<NoiseShader>>("Noise");
+            break;
+        case ANIM_LIFE:
+            anim = std::make_shared<GameOfLife>();
+            break;
 #endif
     }
 
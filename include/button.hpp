@@ -1,6 +1,7 @@
 #pragma once
 #include <arduino_hal.hpp>
 #include <elapsed_time.hpp>
+#include <event_flags.hpp>
 #include <functional>  // for std::function
 #include <vector>      // for std::vector
 
@@ -49,6 +50,12 @@ class Button {
 
     bool IsPressed() const;
     size_t GetTimeInState() const;
+    int GetPin() const { return m_pin; }
+
+    // how long until Update() could send an event without the pin changing
+    // (the end of debouncing, a delayed or long press, or a repeat), or
+    // EventFlags::FOREVER if only a pin change can
+    size_t GetMsUntilTimedEvent() const;
 
     void SetEnabled(const bool enabled);
 
@@ -75,6 +82,8 @@ class Joystick {
   private:
     std::vector<Button*> m_buttons;
 
+    static void OnPinChange();
+
   public:
     Button up{PIN_BTN_UP};
     Button down{PIN_BTN_DOWN};
@@ -85,10 +94,16 @@ class Joystick {
     Joystick();
 
     int AreAnyButtonsPressed();
+    // these block until a button's pin changes (or a button is due to send
+    // a timed event), rather than polling
     bool WaitForButton(const Button& btn, const int ms = -1);
 
     void WaitForNoButtonsPressed();
 
+    // until a button's pin changes or one has a timed event due, for at most
+    // |timeoutMs|. False if it timed out.
+    bool WaitForInput(const size_t timeoutMs);
+
     void Reset();
 
     void Update();
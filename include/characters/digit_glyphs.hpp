@@ -0,0 +1,204 @@
+#pragma once
+#include <stdint.h>
+#include <array>
+
+// The digits (and space) are shared between the character .inc files and
+// DigitTransition, which precomputes its morph tables from them at compile
+// time. On the FC2, these are the PXL mode digits.
+class DigitGlyphs {
+  public:
+    enum {
+#if FCOS_CARDCLOCK || FCOS_CARDCLOCK2
+        COLS = 3,
+        ROWS = 5,
+#elif FCOS_FOXIECLOCK
+        COLS = 2,
+        ROWS = 10,
+#endif
+        CELLS = COLS * ROWS,
+        SPACE = 10,
+        COUNT = 11,  // 0-9 and space
+    };
+
+    using Glyph = std::array<uint8_t, CELLS>;
+
+    // returns -1 for anything that isn't a digit or space
+    static constexpr int Index(const char character) {
+        return character == ' '                          ? SPACE
+               : (character >= '0' && character <= '9') ? character - '0'
+                                                        : -1;
+    }
+
+    // clang-format off
+    static constexpr std::array<Glyph, COUNT> GLYPHS = {{
+#if FCOS_CARDCLOCK || FCOS_CARDCLOCK2
+        {0, 1, 0,
+         1, 0, 1,
+         1, 0, 1,
+         1, 0, 1,
+         0, 1, 0},
+        {0, 1, 0,
+         1, 1, 0,
+         0, 1, 0,
+         0, 1, 0,
+         0, 1, 0},
+        {1, 1, 0,
+         0, 0, 1,
+         0, 1, 0,
+         1, 0, 0,
+         1, 1, 1},
+        {1, 1, 0,
+         0, 0, 1,
+         0, 1, 0,
+         0, 0, 1,
+         1, 1, 0},
+        {0, 0, 1,
+         0, 1, 1,
+         1, 0, 1,
+         1, 1, 1,
+         0, 0, 1},
+        {1, 1, 1,
+         1, 0, 0,
+         1, 1, 1,
+         0, 0, 1,
+         1, 1, 0},
+        {0, 1, 1,
+         1, 0, 0,
+         1, 1, 0,
+         1, 0, 1,
+         0, 1, 0},
+        {1, 1, 1,
+         0, 0, 1,
+         0, 1, 0,
+         1, 0, 0,
+         1, 0, 0},
+        {0, 1, 0,
+         1, 0, 1,
+         0, 1, 0,
+         1, 0, 1,
+         0, 1, 0},
+        {0, 1, 0,
+         1, 0, 1,
+         0, 1, 1,
+         0, 0, 1,
+         1, 1, 0},
+        {0, 0, 0,
+         0, 0, 0,
+         0, 0, 0,
+         0, 0, 0,
+         0, 0, 0},
+#elif FCOS_FOXIECLOCK
+        {0,    1,
+            1,    1,
+         1,    0,
+            0,    1,
+         1,    0,
+            0,    1,
+         1,    0,
+            0,    1,
+         1,    1,
+            1,    0},
+        {0,    1,
+            1,    0,
+         0,    1,
+            0,    0,
+         0,    1,
+            0,    0,
+         0,    1,
+            0,    0,
+         0,    1,
+            0,    0},
+        {0,    1,
+            1,    1,
+         1,    0,
+            0,    1,
+         0,    1,
+            1,    0,
+         1,    0,
+            0,    0,
+         1,    1,
+            1,    1},
+        {1,    1,
+            1,    1,
+         0,    0,
+            0,    1,
+         0,    1,
+            0,    1,
+         0,    0,
+            0,    1,
+         1,    1,
+            1,    0},
+        {0,    0,
+            0,    1,
+         0,    1,
+            1,    1,
+         1,    0,
+            1,    1,
+         1,    1,
+            0,    1,
+         0,    0,
+            0,    1},
+        {1,    1,
+            1,    1,
+         1,    0,
+            1,    0,
+         0,    1,
+            0,    1,
+         0,    0,
+            0,    1,
+         1,    1,
+            1,    0},
+        {0,    1,
+            1,    0,
+         1,    0,
+            0,    0,
+         1,    1,
+            1,    1,
+         1,    0,
+            0,    1,
+         1,    1,
+            1,    0},
+        {1,    1,
+            1,    1,
+         0,    0,
+            0,    1,
+         0,    1,
+            0,    0,
+         0,    1,
+            1,    0,
+         0,    0,
+            1,    0},
+        {0,    1,
+            1,    1,
+         1,    0,
+            0,    1,
+         1,    1,
+            1,    1,
+         1,    0,
+            0,    1,
+         1,    1,
+            1,    0},
+        {0,    1,
+            1,    1,
+         1,    0,
+            0,    1,
+         1,    1,
+            1,    1,
+         0,    0,
+            0,    1,
+         0,    1,
+            1,    0},
+        {0,    0,
+            0,    0,
+         0,    0,
+            0,    0,
+         0,    0,
+            0,    0,
+         0,    0,
+            0,    0,
+         0,    0,
+            0,    0},
+#endif
+    }};
+    // clang-format on
+};
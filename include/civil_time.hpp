@@ -0,0 +1,43 @@
+#pragma once
+#include <stdint.h>
+
+// Conversions between dates in the (proleptic) Gregorian calendar and days
+// since 1970-01-01, from Howard Hinnant's date algorithms. They work for
+// any date, without tables or loops over the years.
+struct CivilTime {
+    enum : int32_t {
+        DAY_S = 24 * 60 * 60,
+    };
+
+    static int64_t DaysFromCivil(int64_t y, const int m, const int d) {
+        y -= m <= 2;
+        const int64_t era = (y >= 0 ? y : y - 399) / 400;
+        const int64_t yoe = y - era * 400;
+        const int64_t doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+        const int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        return era * 146097 + doe - 719468;
+    }
+
+    static void CivilFromDays(const int64_t days, int64_t& y, int& m, int& d) {
+        const int64_t z = days + 719468;
+        const int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+        const int64_t doe = z - era * 146097;
+        const int64_t yoe =
+            (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+        const int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+        const int64_t mp = (5 * doy + 2) / 153;
+        d = doy - (153 * mp + 2) / 5 + 1;
+        m = mp < 10 ? mp + 3 : mp - 9;
+        y = yoe + era * 400 + (m <= 2);
+    }
+
+    // rounds towards the past, unlike /
+    static int64_t DaysFromEpoch(const int64_t t) {
+        return t >= 0 ? t / DAY_S : (t - DAY_S + 1) / DAY_S;
+    }
+
+    // 0 = Sunday
+    static int WeekdayFromDays(const int64_t days) {
+        return (int)(((days + 4) % 7 + 7) % 7);
+    }
+};
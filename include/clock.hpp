@@ -1,8 +1,11 @@
 #pragma once
 #include <stdint.h>
 
+#include <analog_rings.hpp>
 #include <animators.hpp>
 #include <button.hpp>
+#include <clock_face.hpp>
+#include <digit_transition.hpp>
 #include <display.hpp>
 #include <dprint.hpp>
 #include <elapsed_time.hpp>
@@ -13,23 +16,60 @@
 
 class Clock : public Display {
   private:
+    enum {
+        CROSSFADE_MS_DEFAULT = 750,
+        SAVE_DELAY_MS = 2000,
+        BACKGROUND_HALF_LIFE_MS = 140,
+    };
+
     std::shared_ptr<Rtc> m_rtc;
     size_t m_animMode{0};
-    bool m_shouldSaveSettings{false};
-
-    ElapsedTime m_waitingToSaveSettings;
+    int m_profileAnimation{0};  // ANIM for the power profile, 0 = the setting
+    // saves the settings a little after the last change
+    TimerWheel::Id m_saveTimer{TimerWheel::INVALID};
 
-    bool m_blinkerRunning{false};
-    ElapsedTime m_blinkerTimer;
+    // the colon's breath, and whether the face is static until the tick
+    ClockFace m_face;
+    bool m_isBreathShown{false};
 
     RgbColor m_currentColor{0};
     std::shared_ptr<Animator> m_anim;
+    // when BG picks a different mode than ANIM, this draws the background
+    // while m_anim only provides the digit colors
+    std::shared_ptr<BackgroundEffect> m_background;
+    int m_backgroundMode{-1};
+    // what m_background draws, composed under the digits every frame. It
+    // fades about as fast as Darken() every frame at 30 FPS would.
+    Pixels::Layer m_backgroundLayer{BACKGROUND_HALF_LIFE_MS};
+    // the FrameStats bucket, e.g. "CLOCK/Snow+Stars", only changes with them
+    std::string m_statsBucket;
+
+    // when switching ANIM modes, the outgoing animator keeps running into its
+    // own buffer and is blended with the incoming one for ANIM_XFADE_MS
+    struct Transition {
+        bool active{false};
+        std::shared_ptr<Animator> from;
+        Pixels::Buffer fromBuffer;
+        Pixels::Buffer toBuffer;
+        ElapsedTime elapsed;
+        size_t durationMs{0};
+        uint8_t amount{0};  // 0 = only |from|, 255 = only the new animator
+    } m_transition;
+
+    // per digit, what was drawn last and how it is changing (DIGIT_FX)
+    char m_shownDigits[4]{0};
+    DigitTransition m_digitTransitions[4];
 
   public:
-    Clock(std::shared_ptr<Rtc> rtc) : Display(), m_rtc(rtc) {}
+    Clock(std::shared_ptr<Rtc> rtc) : Display(), m_rtc(rtc) {
+        m_name = "CLOCK";
+    }
 
+    virtual void Initialize() override;
     virtual void Activate();
     virtual void Update() override;
+    virtual void ApplyProfile(const PowerProfile& profile) override;
+    virtual bool IsStaticUntilNextTick() override;
 
     void SetAnimator(std::shared_ptr<Animator> anim);
 
@@ -41,9 +81,22 @@ class Clock : public Display {
     virtual void Press(const Button::Event_e evt) override;
 
   private:
+    void StartTransition(std::shared_ptr<Animator> anim);
+    void UpdateBackground();
+    void UpdateStatsBucket();
+    void UpdateAnimators();
+    RgbColor TransitionColor(
+        const std::function<RgbColor(DigitColorSource& a)>& get);
+    RgbColor DigitColor(const size_t index, const bool end = false);
+    RgbColor ColonColor(const bool end = false);
+
     void DrawClockDigits(const RgbColor color);
+    void DrawDigit(const size_t index,
+                   const int x,
+                   const int y,
+                   const char character);
     void DrawSeparator(const int x, RgbColor color);
+    DigitTransition::Style_e GetDigitTransitionStyle();
     void PrepareToSaveSettings();
-    void CheckIfWaitingToSaveSettings();
     void LoadSettings();
 };
\ No newline at end of file
@@ -0,0 +1,87 @@
+#pragma once
+#include <stdint.h>
+#include <stdlib.h>  // for abs()
+#include <algorithm>
+
+// Keeps track of how fast the RTC's crystal runs compared to NTP, and
+// corrects for it between syncs. The PCF8563 doesn't have an offset
+// register to trim, so the correction is made in whole seconds: the drift
+// is added up every tick, and once it amounts to half a second the clock is
+// stepped by one. The better the drift is known, the less the clock is
+// off at each sync, and the longer it waits before the next one.
+class ClockDiscipline {
+  public:
+    enum : int32_t {
+        SECOND_US = 1000000,
+        MIN_INTERVAL_S = 60 * 60,
+        MAX_INTERVAL_S = 24 * 60 * 60,
+        // syncs closer together than this are too short to measure drift
+        MIN_MEASURE_S = 15 * 60,
+        MAX_DRIFT_PPM = 200,
+        // when the drift was predicted to within this at a sync, it waits
+        // twice as long for the next one, and half as long when it's more
+        // than twice this
+        TARGET_OFFSET_US = 250000,
+    };
+
+    // |offsetUs| is how far ahead the RTC (with the corrections from Tick())
+    // was of NTP when the sync arrived, |sinceLastSyncS| is how many ticks
+    // that was after the last one. The clock is expected to be set to NTP
+    // afterwards, see SetBaseline().
+    void OnSync(const int64_t offsetUs, const uint32_t sinceLastSyncS) {
+        if (m_syncs > 0 && sinceLastSyncS >= MIN_MEASURE_S) {
+            // whatever the predicted drift, including the part too small to
+            // have been corrected yet, didn't account for
+            const int64_t error = offsetUs - m_baselineUs - m_accumulatedUs;
+            const float residualPpm = (float)error / sinceLastSyncS;
+
+            // far more than a crystal drifts, the time was set by hand
+            if (std::abs(residualPpm) <= MAX_DRIFT_PPM) {
+                m_driftPpm +=
+                    m_measurements == 0 ? residualPpm : residualPpm / 2;
+                m_measurements++;
+
+                if (std::abs(error) < TARGET_OFFSET_US) {
+                    m_intervalS =
+                        std::min(m_intervalS * 2, (int32_t)MAX_INTERVAL_S);
+                } else if (std::abs(error) > 2 * TARGET_OFFSET_US) {
+                    m_intervalS =
+                        std::max(m_intervalS / 2, (int32_t)MIN_INTERVAL_S);
+                }
+            }
+        }
+        m_syncs++;
+        m_accumulatedUs = 0;
+    }
+
+    // after the clock was set at a sync, whatever sub-second offset it was
+    // left with (the RTC can only be set to whole seconds)
+    void SetBaseline(const int64_t offsetUs) { m_baselineUs = offsetUs; }
+
+    // call once per |seconds| of RTC ticks; returns -1 when the clock should
+    // lose a second, 1 when it should gain one, otherwise 0
+    int Tick(const uint32_t seconds) {
+        m_accumulatedUs += m_driftPpm * seconds;
+        if (m_accumulatedUs >= SECOND_US / 2) {
+            m_accumulatedUs -= SECOND_US;
+            return -1;
+        }
+        if (m_accumulatedUs <= -SECOND_US / 2) {
+            m_accumulatedUs += SECOND_US;
+            return 1;
+        }
+        return 0;
+    }
+
+    float GetDriftPpm() const { return m_driftPpm; }
+    int32_t GetIntervalS() const { return m_intervalS; }
+    uint32_t GetSyncs() const { return m_syncs; }
+
+  private:
+    float m_driftPpm{0};  // positive when the RTC runs fast
+    float m_accumulatedUs{0};
+    int64_t m_baselineUs{0};
+    int32_t m_intervalS{MIN_INTERVAL_S};
+    uint32_t m_syncs{0};
+    uint32_t m_measurements{0};
+};
@@ -0,0 +1,54 @@
+#pragma once
+#include <stdint.h>
+#include <algorithm>  // for std::min
+
+// The parts of the Clock's face that change by themselves, apart from Pixels
+// so that they can be tested on the host. The Clock asks it whether the
+// face is static until the next RTC tick, which is what lets DisplayManager
+// stop drawing frames in between (see Display::IsStaticUntilNextTick()).
+class ClockFace {
+  public:
+    enum : uint32_t {
+        BREATH_MS = 1900,  // the colon breathes for most of every other second
+    };
+
+    // what was on the face in the last frame
+    struct Motion {
+        bool isAnimating;       // the animator's colors or background
+        bool isTransitioning;   // an ANIM cross-fade or a digit changing
+        bool hasSweepingHands;  // the CardClock's rings
+        bool isBreathShown;     // the colon is drawn with UpdateBreath()
+    };
+
+    // A breath starts on an odd second and lasts BREATH_MS, or until late
+    // in the even second after it, whichever is first. Returns how far
+    // through it the colon is, 0-1, or -1 between breaths.
+    float UpdateBreath(const int second, const int millis, const uint32_t ms) {
+        if (second % 2 && !m_isBreathing) {
+            m_isBreathing = true;
+            m_breathStartMs = ms;
+        }
+        if (!m_isBreathing) {
+            return -1.0f;
+        }
+        const uint32_t elapsed = ms - m_breathStartMs;
+        if (elapsed >= BREATH_MS || (!(second % 2) && millis > 900)) {
+            m_isBreathing = false;
+        }
+        return std::min<uint32_t>(elapsed, BREATH_MS) / (float)BREATH_MS;
+    }
+
+    bool IsBreathing() const { return m_isBreathing; }
+
+    // Nothing changes until the tick: the digits only change with the time,
+    // and the next breath starts on a tick too
+    bool IsStaticUntilNextTick(const Motion& motion) const {
+        return !motion.isAnimating && !motion.isTransitioning &&
+               !motion.hasSweepingHands &&
+               !(motion.isBreathShown && m_isBreathing);
+    }
+
+  private:
+    bool m_isBreathing{false};
+    uint32_t m_breathStartMs{0};
+};
@@ -38,7 +38,7 @@ class ConfigMenu : public Display {
     std::shared_ptr<WiFiConfig> m_wifiConfig;
 
   public:
-    ConfigMenu() {}
+    ConfigMenu() { m_name = "CONFIG"; }
 
     virtual void Initialize();
     virtual void Activate() override;
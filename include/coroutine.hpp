@@ -0,0 +1,73 @@
+#pragma once
+#include <stdint.h>
+
+// Stackless coroutines (protothreads), for flows that are easiest to write
+// as a sequence of steps and waits ("show the up arrow, wait for up, show
+// the down arrow...") but mustn't block the loop while they wait. The steps
+// go in Run(), between CO_BEGIN() and CO_END(), and each Resume() carries on
+// from the last CO_YIELD/CO_AWAIT/CO_DELAY to the next one.
+//
+// Run() returns at each wait and starts again at a case label, so:
+// - locals don't survive a wait; anything needed after one is a member
+// - a local that's still in scope at a wait needs a block of its own
+// - the CO_ macros can't be used inside a switch of the flow's own
+class Coroutine {
+  public:
+    virtual ~Coroutine() {}
+
+    // runs until the flow next waits, and returns whether it's still going.
+    // |nowMs| (e.g. millis(), which may wrap) is what CO_DELAY measures.
+    bool Resume(const uint32_t nowMs) {
+        if (m_coLine != DONE) {
+            m_coNowMs = nowMs;
+            Run();
+        }
+        return m_coLine != DONE;
+    }
+
+    bool IsDone() const { return m_coLine == DONE; }
+
+  protected:
+    enum : int {
+        DONE = -1,
+    };
+
+    virtual void Run() = 0;
+
+    int m_coLine{0};  // where Run() carries on from, a __LINE__
+    uint32_t m_coNowMs{0};
+    uint32_t m_coDelayBeginMs{0};
+};
+
+#define CO_BEGIN()       \
+    switch (m_coLine) {  \
+        case 0:
+
+// until the next Resume(), e.g. the next frame
+#define CO_YIELD()            \
+    do {                      \
+        m_coLine = __LINE__;  \
+        return;               \
+        case __LINE__:;       \
+    } while (0)
+
+// until |cond| is true, checked once per Resume()
+#define CO_AWAIT(cond)        \
+    do {                      \
+        m_coLine = __LINE__;  \
+        [[fallthrough]];      \
+        case __LINE__:        \
+            if (!(cond)) {    \
+                return;       \
+            }                 \
+    } while (0)
+
+#define CO_DELAY(ms)                                                   \
+    do {                                                               \
+        m_coDelayBeginMs = m_coNowMs;                                  \
+        CO_AWAIT((uint32_t)(m_coNowMs - m_coDelayBeginMs) >= (ms));    \
+    } while (0)
+
+#define CO_END()      \
+    }                 \
+    m_coLine = DONE
@@ -0,0 +1,153 @@
+#pragma once
+#include <stdint.h>
+#include <array>
+
+#include <characters/digit_glyphs.hpp>
+
+// The tables behind DigitTransition's STYLE_MORPH and STYLE_DISSOLVE, built
+// at compile time from DigitGlyphs. They're apart from DigitTransition,
+// which draws with Pixels, so that they can be tested on the host.
+class DigitMorphs {
+  public:
+    enum {
+        COLS = DigitGlyphs::COLS,
+        ROWS = DigitGlyphs::ROWS,
+        CELLS = DigitGlyphs::CELLS,
+        STEPS = 5,  // intermediate positions are snapped to LEDs
+    };
+
+    using Glyph = DigitGlyphs::Glyph;
+
+    struct MorphPath {
+        uint8_t cells[STEPS + 1];  // cell index at each step
+    };
+
+    struct Morph {
+        enum Fade_e {
+            FADE_NONE,
+            FADE_IN,   // from a space
+            FADE_OUT,  // to a space
+        };
+        uint8_t numPaths{0};
+        uint8_t fade{FADE_NONE};
+        MorphPath paths[CELLS]{};
+    };
+
+    using Table = std::array<std::array<Morph, DigitGlyphs::COUNT>,
+                             DigitGlyphs::COUNT>;
+    using Ranks = std::array<uint8_t, CELLS>;
+
+    static constexpr Morph Build(const Glyph& from, const Glyph& to) {
+        Morph morph{};
+        uint8_t fromCells[CELLS]{};
+        uint8_t toCells[CELLS]{};
+        int numFrom = 0, numTo = 0;
+        for (int cell = 0; cell < CELLS; ++cell) {
+            if (from[cell]) {
+                fromCells[numFrom++] = cell;
+            }
+            if (to[cell]) {
+                toCells[numTo++] = cell;
+            }
+        }
+
+        if (numFrom == 0 || numTo == 0) {
+            // nothing to travel to/from (a space), so pixels fade in place
+            const uint8_t* cells = numFrom ? fromCells : toCells;
+            morph.numPaths = numFrom + numTo;
+            morph.fade = numFrom ? Morph::FADE_OUT : Morph::FADE_IN;
+            for (int i = 0; i < morph.numPaths; ++i) {
+                for (int step = 0; step <= STEPS; ++step) {
+                    morph.paths[i].cells[step] = cells[i];
+                }
+            }
+            return morph;
+        }
+
+        // every pixel of the glyph with more pixels gets a path to the
+        // nearest unclaimed pixel of the other glyph. Once all of those are
+        // claimed, paths start sharing their destination (or source).
+        const bool fromHasMore = numFrom >= numTo;
+        const uint8_t* more = fromHasMore ? fromCells : toCells;
+        const uint8_t* fewer = fromHasMore ? toCells : fromCells;
+        const int numMore = fromHasMore ? numFrom : numTo;
+        const int numFewer = fromHasMore ? numTo : numFrom;
+        bool claimed[CELLS]{};
+
+        for (int i = 0; i < numMore; ++i) {
+            int best = 0;
+            int bestDistance = 0x7FFF;
+            for (int j = 0; j < numFewer; ++j) {
+                const int distance = CellDistance(more[i], fewer[j]) +
+                                     (claimed[j] ? 0x100 : 0);
+                if (distance < bestDistance) {
+                    best = j;
+                    bestDistance = distance;
+                }
+            }
+            claimed[best] = true;
+
+            const int src = fromHasMore ? more[i] : fewer[best];
+            const int dst = fromHasMore ? fewer[best] : more[i];
+            for (int step = 0; step <= STEPS; ++step) {
+                morph.paths[i].cells[step] = InterpolateCell(src, dst, step);
+            }
+        }
+        morph.numPaths = numMore;
+        return morph;
+    }
+
+    // a Morph for every pair of glyphs, [from][to]
+    static constexpr Table BuildTable() {
+        Table table{};
+        for (int from = 0; from < DigitGlyphs::COUNT; ++from) {
+            for (int to = 0; to < DigitGlyphs::COUNT; ++to) {
+                table[from][to] = Build(DigitGlyphs::GLYPHS[from],
+                                        DigitGlyphs::GLYPHS[to]);
+            }
+        }
+        return table;
+    }
+
+    // a fixed shuffle of the cells: during STYLE_DISSOLVE, each cell
+    // switches from the old to the new digit once the progress passes its
+    // rank
+    static constexpr Ranks BuildDissolveRanks() {
+        Ranks order{};
+        for (int i = 0; i < CELLS; ++i) {
+            order[i] = i;
+        }
+        uint32_t seed = 0xF0C5;
+        for (int i = CELLS - 1; i > 0; --i) {
+            seed = seed * 1103515245 + 12345;
+            const int j = (seed >> 16) % (i + 1);
+            const uint8_t swap = order[i];
+            order[i] = order[j];
+            order[j] = swap;
+        }
+
+        Ranks ranks{};
+        for (int i = 0; i < CELLS; ++i) {
+            ranks[order[i]] = i;
+        }
+        return ranks;
+    }
+
+  private:
+    static constexpr int CellDistance(const int a, const int b) {
+        const int cols = (a % COLS) - (b % COLS);
+        const int rows = (a / COLS) - (b / COLS);
+        return cols * cols + rows * rows;
+    }
+
+    // position of a pixel travelling from cell a to cell b, snapped to an LED
+    static constexpr uint8_t InterpolateCell(const int a,
+                                             const int b,
+                                             const int step) {
+        const int col = ((a % COLS) * (STEPS - step) + (b % COLS) * step +
+                         STEPS / 2) / STEPS;
+        const int row = ((a / COLS) * (STEPS - step) + (b / COLS) * step +
+                         STEPS / 2) / STEPS;
+        return row * COLS + col;
+    }
+};
@@ -0,0 +1,87 @@
+#pragma once
+#include <characters/digit_glyphs.hpp>
+#include <digit_morphs.hpp>
+#include <pixels.hpp>
+
+// Plays a short transition on a single clock digit when it changes (e.g. on
+// minute rollover). Every path used by STYLE_MORPH is precomputed at compile
+// time from DigitGlyphs (see DigitMorphs), so the per-frame cost is a table walk over the lit
+// pixels of the two glyphs.
+class DigitTransition {
+  public:
+    enum Style_e {
+        STYLE_NONE,      // new digit is drawn immediately
+        STYLE_SLIDE,     // old digit slides up, new digit follows from below
+        STYLE_DISSOLVE,  // pixels flip from old to new in a scattered order
+        STYLE_MORPH,     // old pixels travel to the nearest new pixels
+        STYLE_TOTAL,
+    };
+
+    enum {
+        DURATION_MS = 450,
+        MORPH_STEPS = DigitMorphs::STEPS,
+        PROGRESS_MAX = 255,
+    };
+
+    using MorphPath = DigitMorphs::MorphPath;
+    using Morph = DigitMorphs::Morph;
+
+  private:
+    Style_e m_style{STYLE_NONE};
+    int m_from{DigitGlyphs::SPACE};
+    int m_to{DigitGlyphs::SPACE};
+    size_t m_elapsedMs{DURATION_MS};
+
+  public:
+    // characters that aren't digits or spaces are never transitioned
+    void Start(const char from, const char to, const Style_e style);
+
+    bool IsActive() const;
+
+    // deltaMs is the time since the previous frame
+    void Update(const size_t deltaMs);
+
+    // draws the in-between glyph with its top left at x,y (y is unused on the
+    // FC2, where each digit is a strip of LEDs). Instantiated for Pixels in
+    // digit_transition.cpp
+    template <typename Geometry>
+    void Draw(BasicPixels<Geometry>& pixels,
+              const int x,
+              const int y,
+              const RgbColor beginColor,
+              const RgbColor endColor) const;
+
+    static const Morph& GetMorph(const int from, const int to);
+
+  private:
+    uint8_t GetProgress() const;
+
+    template <typename Geometry>
+    void DrawSlide(BasicPixels<Geometry>& pixels,
+                   const int x,
+                   const int y,
+                   const RgbColor beginColor,
+                   const RgbColor endColor) const;
+    template <typename Geometry>
+    void DrawDissolve(BasicPixels<Geometry>& pixels,
+                      const int x,
+                      const int y,
+                      const RgbColor beginColor,
+                      const RgbColor endColor) const;
+    template <typename Geometry>
+    void DrawMorph(BasicPixels<Geometry>& pixels,
+                   const int x,
+                   const int y,
+                   const RgbColor beginColor,
+                   const RgbColor endColor) const;
+
+    static RgbColor GetCellColor(const RgbColor beginColor,
+                                 const RgbColor endColor,
+                                 const int cell);
+    template <typename Geometry>
+    static void SetCell(BasicPixels<Geometry>& pixels,
+                        const int x,
+                        const int y,
+                        const int cell,
+                        const RgbColor color);
+};
@@ -6,9 +6,12 @@
 #include <button.hpp>
 #include <dprint.hpp>
 #include <elapsed_time.hpp>
+#include <idle_detector.hpp>
 #include <pixels.hpp>
+#include <power_profile.hpp>
 #include <rtc.hpp>
 #include <settings.hpp>
+#include <timer_wheel.hpp>
 
 class DisplayManager;  // forward declaration
 
@@ -36,6 +39,7 @@ class Display {
     std::shared_ptr<Pixels> m_pixels;
     std::shared_ptr<Settings> m_settings;
     std::shared_ptr<Rtc> m_rtc;
+    std::shared_ptr<TimerWheel> m_timers;
     DisplayManager* m_manager{nullptr};  // set by DisplayManager::Add()
 
   protected:
@@ -54,6 +58,12 @@ class Display {
     virtual bool Right(const Button::Event_e evt) { return false; }
     virtual bool ShouldTimeout() { return true; }
     virtual void Timeout() {}
+    // when the time of day moves into another power profile
+    virtual void ApplyProfile(const PowerProfile& profile) {}
+    // whether the last frame stays the same until the RTC ticks or a button
+    // is pressed, which lets DisplayManager stop drawing frames until then.
+    // Anything that animates says no while it's animating
+    virtual bool IsStaticUntilNextTick() { return false; }
 
     bool IsDone() const { return m_done; }
 
@@ -64,12 +74,16 @@ class DisplayManager {
   private:
     enum {
         TIMEOUT_MS = 10000,
+        // the light sensor's range is split into this many steps, and moving
+        // to another one isn't idle
+        BRIGHTNESS_BUCKETS = 32,
     };
 
     std::shared_ptr<Pixels> m_pixels;
     std::shared_ptr<Settings> m_settings;
     std::shared_ptr<Rtc> m_rtc;
     std::shared_ptr<Joystick> m_joy;
+    std::shared_ptr<TimerWheel> m_timers;
 
     std::vector<std::shared_ptr<Display>> m_displays;
     size_t m_activeDisplay{0};
@@ -78,14 +92,28 @@ class DisplayManager {
     bool m_isTempDisplay{false};
     bool m_isFirstUpdate{true};
 
-    ElapsedTime m_timeSinceButtonPress;
+    // a non-default display goes back to the default TIMEOUT_MS after the
+    // last button press
+    TimerWheel::Id m_timeoutTimer;
+    bool m_hasTimedOut{false};
     ElapsedTime m_sinceLastUpdate;
+    size_t m_frameDeltaMs{0};
+
+    // the NITE settings, as a schedule of power profiles by time of day
+    ProfileSchedule m_profiles;
+    PowerProfile m_profile;
+
+    // while the clock isn't changing, it's only drawn for events (IDLE)
+    IdleDetector m_idle;
+    bool m_isIdleEnabled{true};
+    size_t m_lastTickUptime{0};
 
   public:
     DisplayManager(std::shared_ptr<Pixels> pixels,
                    std::shared_ptr<Settings> settings,
                    std::shared_ptr<Rtc> rtc,
-                   std::shared_ptr<Joystick> joy);
+                   std::shared_ptr<Joystick> joy,
+                   std::shared_ptr<TimerWheel> timers);
 
     void Add(std::shared_ptr<Display> display);
 
@@ -93,6 +121,14 @@ class DisplayManager {
 
     std::shared_ptr<Display> GetActive();
 
+    // time between the start of the previous frame and the current one, for
+    // Displays that animate at a fixed speed regardless of frame rate
+    size_t GetFrameDeltaMs() const { return m_frameDeltaMs; }
+
+    // nothing needs drawing until the RTC ticks or a button is pressed, so
+    // the loop can wait for them
+    bool IsIdle();
+
     void SetDefaultAndActivateDisplay(const size_t displayNum);
 
     void ActivateDisplay(const size_t displayNum);
@@ -101,7 +137,9 @@ class DisplayManager {
 
   private:
     void ConfigureJoystick();
+    void LoadProfiles();
+    void ApplyProfile(const PowerProfile& profile);
+    size_t GetFrameMs();
 
-    void ResetTimeSinceButtonPress();
-    size_t GetTimeSinceButtonPress();
+    void RestartTimeout();
 };
@@ -0,0 +1,12 @@
+#pragma once
+
+// The display's defaults that a PowerProfile starts from, apart from
+// pixels.hpp so that power_profile.hpp builds on the host
+enum DisplayDefaults_e {
+    FRAMES_PER_SECOND = 30,
+
+    MIN_DISPLAY_BRIGHTNESS_DEFAULT = 1,
+    MAX_DISPLAY_BRIGHTNESS = 9,
+
+    CPU_MHZ_DEFAULT = 160,
+};
@@ -12,12 +12,15 @@ class ElapsedTime {
     size_t Ms() const { return millis() - m_millis; }
     size_t S() const { return Ms() / 1000; }
 
+    // blocks for |ms| so other tasks (WiFi) get the CPU, or when |hard|,
+    // spins without giving it up
     static void Delay(const size_t ms, const bool hard = false) {
+        if (!hard) {
+            delay(ms);
+            return;
+        }
         ElapsedTime delayTime;
-        do {
-            if (!hard) {
-                delay(1);
-            }
-        } while (delayTime.Ms() < ms);
+        while (delayTime.Ms() < ms) {
+        }
     }
 };
@@ -0,0 +1,132 @@
+#pragma once
+#include <stdint.h>
+
+#include <arduino_hal.hpp>
+#if ARDUINO && FCOS_ESP32_C3
+#include <freertos/FreeRTOS.h>
+#include <freertos/event_groups.h>
+#elif ARDUINO
+#include <atomic>
+#else
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#endif
+
+#ifndef IRAM_ATTR
+#define IRAM_ATTR  // only the targets need ISRs in IRAM
+#endif
+
+// Bits that interrupts and the SDK's callbacks set, and that the loop can
+// block on until one of them is set or a timeout passes, instead of polling.
+// On the ESP32 it's a FreeRTOS event group, so the waiting task doesn't run
+// at all and WiFi and the idle task get the CPU. The ESP8266's Arduino core
+// has no scheduler to block in, so it delay()s between checks, which still
+// lets the SDK run. On the host (tests) it's a condition variable.
+class EventFlags {
+  public:
+    enum : uint32_t {
+        FOREVER = 0xFFFFFFFF,
+    };
+
+    EventFlags() {
+#if ARDUINO && FCOS_ESP32_C3
+        m_group = xEventGroupCreateStatic(&m_groupBuffer);
+#endif
+    }
+
+    EventFlags(const EventFlags&) = delete;
+    EventFlags& operator=(const EventFlags&) = delete;
+
+    void Set(const uint32_t bits) {
+#if ARDUINO && FCOS_ESP32_C3
+        xEventGroupSetBits(m_group, bits);
+#elif ARDUINO
+        m_bits.fetch_or(bits);
+#else
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_bits |= bits;
+        m_changed.notify_all();
+#endif
+    }
+
+    void IRAM_ATTR SetFromISR(const uint32_t bits) {
+#if ARDUINO && FCOS_ESP32_C3
+        BaseType_t woken = pdFALSE;
+        xEventGroupSetBitsFromISR(m_group, bits, &woken);
+        if (woken) {
+            portYIELD_FROM_ISR();
+        }
+#else
+        Set(bits);
+#endif
+    }
+
+    void Clear(const uint32_t bits) {
+#if ARDUINO && FCOS_ESP32_C3
+        xEventGroupClearBits(m_group, bits);
+#elif ARDUINO
+        m_bits.fetch_and(~bits);
+#else
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_bits &= ~bits;
+#endif
+    }
+
+    // blocks until any of |bits| is set or |timeoutMs| passes. Returns the
+    // ones of |bits| that were set, which are cleared, or 0 on a timeout.
+    uint32_t Wait(const uint32_t bits, const uint32_t timeoutMs) {
+#if ARDUINO && FCOS_ESP32_C3
+        const TickType_t ticks =
+            timeoutMs == FOREVER ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs);
+        return xEventGroupWaitBits(m_group, bits, pdTRUE, pdFALSE, ticks) &
+               bits;
+#elif ARDUINO
+        const unsigned long beginMs = millis();
+        for (;;) {
+            const uint32_t set = m_bits.fetch_and(~bits) & bits;
+            if (set || (timeoutMs != FOREVER && millis() - beginMs >= timeoutMs)) {
+                return set;
+            }
+            delay(1);
+        }
+#else
+        std::unique_lock<std::mutex> lock(m_mutex);
+        const auto isSet = [&] { return (m_bits & bits) != 0; };
+        if (timeoutMs == FOREVER) {
+            m_changed.wait(lock, isSet);
+        } else {
+            m_changed.wait_for(lock, std::chrono::milliseconds(timeoutMs),
+                               isSet);
+        }
+        const uint32_t set = m_bits & bits;
+        m_bits &= ~bits;
+        return set;
+#endif
+    }
+
+  private:
+#if ARDUINO && FCOS_ESP32_C3
+    StaticEventGroup_t m_groupBuffer;
+    EventGroupHandle_t m_group;
+#elif ARDUINO
+    std::atomic<uint32_t> m_bits{0};
+#else
+    std::mutex m_mutex;
+    std::condition_variable m_changed;
+    uint32_t m_bits{0};
+#endif
+};
+
+// What the main loop, and anything that blocks in it, waits for
+enum LoopEvent_e : uint32_t {
+    EVENT_BUTTON = 1 << 0,    // a button's pin changed
+    EVENT_RTC_TICK = 1 << 1,  // the RTC's 1Hz interrupt
+};
+
+// one set for the whole firmware, since the ISRs that set it can't be
+// handed one
+inline EventFlags& LoopEvents() {
+    static EventFlags events;
+    return events;
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include <stdint.h>
+#include <stdio.h>  // for snprintf
+#include <map>
+#include <string>
+
+// Counts how much of each frame actually changes: LEDs written, LEDs whose
+// color changed since the previous frame, and the time spent sending the
+// frame. Frames are added to whichever bucket is current when they end,
+// which is named after the active Display and Animator (e.g. "CLOCK/Snow"),
+// so the numbers show which of them would gain from dirty tracking,
+// partial updates or a lower frame rate. Nothing is counted until it's
+// enabled, as counting the changed LEDs takes a pass over every frame.
+class FrameStats {
+  public:
+    struct Counters {
+        uint32_t frames{0};
+        uint32_t written{0};
+        uint32_t changed{0};
+        uint32_t unchangedFrames{0};  // frames that didn't change any LED
+        uint64_t transmitUs{0};
+        uint32_t maxTransmitUs{0};
+    };
+
+    void SetEnabled(const bool isEnabled) { m_isEnabled = isEnabled; }
+
+    bool IsEnabled() const { return m_isEnabled; }
+
+    void SetBucket(const std::string& name) { m_bucket = name; }
+
+    const std::string& GetBucket() const { return m_bucket; }
+
+    void CountWrite() { m_written += m_isEnabled; }
+
+    // adds the frame that was just sent to the current bucket. |changed| is
+    // the number of LEDs that differ from the previous frame, which can be
+    // far fewer than were written (e.g. darkened, then drawn again).
+    void EndFrame(const uint32_t changed, const uint32_t transmitUs) {
+        if (!m_isEnabled) {
+            return;
+        }
+        Counters& c = m_buckets[m_bucket];
+        ++c.frames;
+        c.written += m_written;
+        c.changed += changed;
+        c.unchangedFrames += changed == 0;
+        c.transmitUs += transmitUs;
+        if (transmitUs > c.maxTransmitUs) {
+            c.maxTransmitUs = transmitUs;
+        }
+        m_written = 0;
+    }
+
+    const std::map<std::string, Counters>& GetBuckets() const {
+        return m_buckets;
+    }
+
+    void Reset() { m_buckets.clear(); }
+
+    // one line per bucket with per-frame averages, for the serial port or
+    // whatever else wants to show them
+    std::string Report() const {
+        std::string report;
+        for (const auto& bucket : m_buckets) {
+            const Counters& c = bucket.second;
+            if (c.frames == 0) {
+                continue;
+            }
+            char line[160];
+            snprintf(line, sizeof(line),
+                     "%-24s frames:%-6u written:%-5u changed:%-5u idle:%3u%% "
+                     "tx:%uus (max %uus)\n",
+                     bucket.first.c_str(), (unsigned)c.frames,
+                     (unsigned)(c.written / c.frames),
+                     (unsigned)(c.changed / c.frames),
+                     (unsigned)(c.unchangedFrames * 100 / c.frames),
+                     (unsigned)(c.transmitUs / c.frames),
+                     (unsigned)c.maxTransmitUs);
+            report += line;
+        }
+        return report;
+    }
+
+  private:
+    bool m_isEnabled{false};
+    uint32_t m_written{0};  // in the frame being drawn
+    std::string m_bucket{"?"};
+    std::map<std::string, Counters> m_buckets;
+};
@@ -0,0 +1,106 @@
+#pragma once
+#include <stdint.h>
+#include <array>
+
+// How the matrix LEDs are wired, as seen from the front
+enum GeometryLayout_e {
+    LAYOUT_ROWS,                // every row left to right
+    LAYOUT_ROWS_SERPENTINE,     // odd rows run right to left (zig-zag)
+    LAYOUT_COLUMNS_SERPENTINE,  // columns top to bottom, odd ones bottom up
+};
+
+// A Geometry describes the LEDs that Pixels drives. Everything that draws
+// uses logical positions: the matrix row by row, then the rings (12 LEDs
+// each, starting at 1:00), then any option LEDs. CHAIN maps each logical
+// position to where that LED actually is on the chain, so a different
+// wiring is a different table rather than a branch per pixel. Boards whose
+// rings are wired differently can derive from this and replace CHAIN.
+//
+// Large matrices can split the chain into OUTPUTS segments of SEGMENT_LEDS
+// (the last one may be shorter), each sent on its own pin at the same time.
+template <int W,
+          int H,
+          int RINGS = 0,
+          int OPTIONS = 0,
+          GeometryLayout_e LAYOUT = LAYOUT_ROWS,
+          int OUTPUTS = 1>
+struct MatrixGeometry {
+    enum : int {
+        WIDTH = W,
+        HEIGHT = H,
+        RING_SIZE = 12,
+        NUM_RINGS = RINGS,
+        OPTION_LEDS = OPTIONS,
+
+        MATRIX_LEDS = W * H,
+        ROUND_LEDS = RING_SIZE * RINGS,
+        FIRST_RING_LED = MATRIX_LEDS,
+        TOTAL_LEDS = MATRIX_LEDS + ROUND_LEDS + OPTIONS,
+
+        NUM_OUTPUTS = OUTPUTS,
+        SEGMENT_LEDS = (TOTAL_LEDS + OUTPUTS - 1) / OUTPUTS,
+    };
+    static_assert(TOTAL_LEDS <= 0xFFFF, "chain positions are 16 bits");
+    static_assert(OUTPUTS >= 1 && TOTAL_LEDS > (OUTPUTS - 1) * SEGMENT_LEDS,
+                  "every output needs at least one LED");
+
+    // the number of LEDs on an output; chain position c is LED
+    // c % SEGMENT_LEDS on output c / SEGMENT_LEDS
+    static constexpr int SegmentLength(const int output) {
+        return output < NUM_OUTPUTS - 1
+                   ? SEGMENT_LEDS
+                   : TOTAL_LEDS - (NUM_OUTPUTS - 1) * SEGMENT_LEDS;
+    }
+
+    static constexpr int MatrixChainPos(const int x, const int y) {
+        switch (LAYOUT) {
+            default:
+            case LAYOUT_ROWS:
+                return y * W + x;
+            case LAYOUT_ROWS_SERPENTINE:
+                return y * W + ((y & 1) ? W - 1 - x : x);
+            case LAYOUT_COLUMNS_SERPENTINE:
+                return x * H + ((x & 1) ? H - 1 - y : y);
+        }
+    }
+
+    static constexpr std::array<uint16_t, TOTAL_LEDS> BuildChain() {
+        std::array<uint16_t, TOTAL_LEDS> chain{};
+        for (int y = 0; y < H; ++y) {
+            for (int x = 0; x < W; ++x) {
+                chain[y * W + x] = MatrixChainPos(x, y);
+            }
+        }
+        // the rings and option LEDs follow the matrix on the chain
+        for (int pos = MATRIX_LEDS; pos < TOTAL_LEDS; ++pos) {
+            chain[pos] = pos;
+        }
+        return chain;
+    }
+
+    static constexpr std::array<uint16_t, TOTAL_LEDS> CHAIN = BuildChain();
+
+    // where a character that would start at column x is drawn instead, for
+    // matrices with columns that can't show text
+    static constexpr int TextColumn(const int x) { return x; }
+};
+
+#if FCOS_FOXIECLOCK
+struct FoxieClockGeometry : public MatrixGeometry<20 + 20 + 2 + 20 + 20,
+                                                  1,
+                                                  0,
+                                                  8 + 2> {
+    // text can't start on the blinkers in the middle, or on the last 2 LEDs
+    // of the third digit, which would run a character into the fourth
+    static constexpr int TextColumn(const int x) {
+        return (x == 40 || x == 41)   ? 42
+               : (x == 60 || x == 61) ? 62
+                                      : x;
+    }
+};
+using ActiveGeometry = FoxieClockGeometry;
+#elif FCOS_CARDCLOCK
+using ActiveGeometry = MatrixGeometry<17, 5, 2>;
+#elif FCOS_CARDCLOCK2
+using ActiveGeometry = MatrixGeometry<17, 11, 3>;
+#endif
@@ -1,13 +1,28 @@
 #include <button.hpp>
+#include <coroutine.hpp>
 #include <memory>
 #include <pixels.hpp>
 #include <rtc.hpp>
 #include <settings.hpp>
+#include <timer_wheel.hpp>
 
-void ShowSerialStatusMessage(std::shared_ptr<Pixels> pixels,
-                             std::shared_ptr<Rtc> rtc);
+// the status line and, every so often, the stats on the serial port
+void StartSerialStatus(std::shared_ptr<TimerWheel> timers,
+                       std::shared_ptr<Pixels> pixels,
+                       std::shared_ptr<Settings> settings,
+                       std::shared_ptr<Rtc> rtc);
 
-void DoHardwareStartupTests(std::shared_ptr<Pixels> pixels,
-                            std::shared_ptr<Settings> settings,
-                            std::shared_ptr<Rtc> rtc,
-                            std::shared_ptr<Joystick> joy);
+// in place of yield() at the end of the loop. While the display is idle,
+// it waits for the next RTC tick, button press or timer instead.
+void WaitForNextEvent(std::shared_ptr<Rtc> rtc,
+                      std::shared_ptr<Settings> settings,
+                      std::shared_ptr<TimerWheel> timers,
+                      const bool isIdle);
+
+// the hardware test or factory reset that the buttons held at power on ask
+// for, if any, as a flow to resume once a frame until it's done
+std::shared_ptr<Coroutine> DoHardwareStartupTests(
+    std::shared_ptr<Pixels> pixels,
+    std::shared_ptr<Settings> settings,
+    std::shared_ptr<Rtc> rtc,
+    std::shared_ptr<Joystick> joy);
@@ -0,0 +1,51 @@
+#pragma once
+#include <stdint.h>
+
+// Works out when the display has stopped changing, so that it only needs
+// drawing again when something happens: the RTC ticks, a button is pressed
+// or the room gets lighter or darker. It's idle after SETTLE_FRAMES frames
+// in a row that didn't change any LED at the same brightness. While idle,
+// the frame drawn for a tick may change (the time did), and the one after
+// it is a probe: if that changes too, something is animating and it's no
+// longer idle. This only backs up the display, which has to say that it's
+// static as well (see Display::IsStaticUntilNextTick()).
+class IdleDetector {
+  public:
+    enum {
+        SETTLE_FRAMES = 30,  // a second at the full frame rate
+    };
+
+    // after each frame, with the number of LEDs it changed
+    void OnFrame(const uint32_t changed, const int brightnessBucket) {
+        const bool wasIdle = IsIdle();
+        if (brightnessBucket != m_brightnessBucket) {
+            m_brightnessBucket = brightnessBucket;
+            m_unchangedFrames = 0;
+        } else if (changed == 0) {
+            if (m_unchangedFrames < SETTLE_FRAMES) {
+                ++m_unchangedFrames;
+            }
+        } else if (!wasIdle || !m_isTickPending) {
+            m_unchangedFrames = 0;
+        }
+        m_isProbePending = wasIdle && m_isTickPending && IsIdle();
+        m_isTickPending = false;
+    }
+
+    void OnTick() { m_isTickPending = true; }
+
+    void OnInput() { m_unchangedFrames = 0; }
+
+    bool IsIdle() const { return m_unchangedFrames >= SETTLE_FRAMES; }
+
+    // idle, and nothing has happened that needs a frame
+    bool CanSkipFrame() const {
+        return IsIdle() && !m_isTickPending && !m_isProbePending;
+    }
+
+  private:
+    uint32_t m_unchangedFrames{0};
+    int m_brightnessBucket{-1};
+    bool m_isTickPending{false};
+    bool m_isProbePending{false};
+};
@@ -0,0 +1,90 @@
+#pragma once
+#include <stdint.h>
+#include <string.h>  // for memcmp
+#include <array>
+#include <memory>
+#include <vector>
+
+// Sends the LED chain of a Geometry on Geometry::NUM_OUTPUTS pins at once.
+// Bus is a NeoPixelBus (or a mock in the tests). Each one holds the pixels
+// of its segment, and Show() starts every bus before any of them has to
+// finish, so with asynchronous methods such as the RMT ones a frame takes
+// as long as the longest segment rather than the whole chain.
+template <typename Geometry, typename Bus>
+class LedOutputs {
+  public:
+    enum {
+        // WS2812: 24 bits of 1.25us each per LED, then a latch/reset gap
+        LED_NS = 24 * 1250,
+        RESET_US = 300,
+        BYTES_PER_LED = 3,  // G R B
+    };
+
+    // makeBus(output, numLEDs) returns a std::unique_ptr<Bus>
+    template <typename MakeBus>
+    explicit LedOutputs(MakeBus makeBus) {
+        for (int i = 0; i < Geometry::NUM_OUTPUTS; ++i) {
+            m_buses[i] = makeBus(i, Geometry::SegmentLength(i));
+        }
+    }
+
+    void Begin() {
+        for (auto& bus : m_buses) {
+            bus->Begin();
+        }
+    }
+
+    void Show() {
+        for (auto& bus : m_buses) {
+            bus->Show();
+        }
+    }
+
+    // chainPos is a position on the chain, e.g. Geometry::CHAIN[pos]
+    template <typename Color>
+    void SetPixelColor(const uint16_t chainPos, const Color& color) {
+        m_buses[chainPos / Geometry::SEGMENT_LEDS]->SetPixelColor(
+            chainPos % Geometry::SEGMENT_LEDS, color);
+    }
+
+    auto GetPixelColor(const uint16_t chainPos) const {
+        return m_buses[chainPos / Geometry::SEGMENT_LEDS]->GetPixelColor(
+            chainPos % Geometry::SEGMENT_LEDS);
+    }
+
+    Bus& GetBus(const int output) { return *m_buses[output]; }
+
+    // compares the frame about to be sent with |lastFrame|, which is then
+    // updated to it. With |countLEDs| it returns how many LEDs differ,
+    // otherwise 1 if any of them do, which a memcmp of each bus can tell.
+    uint32_t DiffFrame(std::vector<uint8_t>& lastFrame, const bool countLEDs) {
+        lastFrame.resize(Geometry::TOTAL_LEDS * BYTES_PER_LED);
+        uint32_t changed = 0;
+        uint8_t* last = lastFrame.data();
+        for (auto& bus : m_buses) {
+            const uint8_t* pixels = bus->Pixels();
+            const size_t size = bus->PixelsSize();
+            if (memcmp(pixels, last, size) != 0) {
+                if (!countLEDs) {
+                    changed = 1;
+                } else {
+                    for (size_t i = 0; i < size; i += BYTES_PER_LED) {
+                        changed +=
+                            memcmp(pixels + i, last + i, BYTES_PER_LED) != 0;
+                    }
+                }
+                memcpy(last, pixels, size);
+            }
+            last += size;
+        }
+        return changed;
+    }
+
+    // how long sending a frame takes when all outputs run in parallel
+    static constexpr uint32_t FrameUs() {
+        return (uint32_t)Geometry::SEGMENT_LEDS * LED_NS / 1000 + RESET_US;
+    }
+
+  private:
+    std::array<std::unique_ptr<Bus>, Geometry::NUM_OUTPUTS> m_buses;
+};
@@ -0,0 +1,134 @@
+#pragma once
+#include <stdint.h>
+#include <array>
+
+// A Game of Life board that wraps around at the edges. Each row is a few
+// words, so a generation computes the neighbour counts of 32 cells at once
+// with bitwise adders instead of visiting the cells one by one. Matrices up
+// to 32 wide (every current board) have single-word rows.
+template <int WIDTH, int HEIGHT>
+class LifeBoard {
+    static_assert(WIDTH > 1 && HEIGHT > 0, "the board needs some cells");
+
+  public:
+    using Word = uint32_t;
+    enum {
+        WORD_BITS = 32,
+        WORDS = (WIDTH + WORD_BITS - 1) / WORD_BITS,
+        LAST_BIT = (WIDTH - 1) % WORD_BITS,  // of the last word
+    };
+    using Row = std::array<Word, WORDS>;
+
+    // the cells in the last word of a row, the bits above are always 0
+    static constexpr Word LAST_WORD_MASK =
+        LAST_BIT == WORD_BITS - 1 ? ~Word(0) : (Word(1) << (LAST_BIT + 1)) - 1;
+
+    bool Get(const int x, const int y) const {
+        return (m_rows[y][x / WORD_BITS] >> (x % WORD_BITS)) & 1;
+    }
+
+    void Set(const int x, const int y, const bool alive) {
+        Word& word = m_rows[y][x / WORD_BITS];
+        if (alive) {
+            word |= Word(1) << (x % WORD_BITS);
+        } else {
+            word &= ~(Word(1) << (x % WORD_BITS));
+        }
+    }
+
+    // cell x is bit (x % WORD_BITS) of word (x / WORD_BITS)
+    const Row& GetRow(const int y) const { return m_rows[y]; }
+
+    void Clear() {
+        for (Row& row : m_rows) {
+            row.fill(0);
+        }
+    }
+
+    int Population() const {
+        int population = 0;
+        for (const Row& row : m_rows) {
+            for (const Word word : row) {
+                population += __builtin_popcount(word);
+            }
+        }
+        return population;
+    }
+
+    bool operator==(const LifeBoard& other) const {
+        return m_rows == other.m_rows;
+    }
+
+    void Step() {
+        std::array<Row, HEIGHT> next;
+        for (int y = 0; y < HEIGHT; ++y) {
+            const Row& up = m_rows[(y + HEIGHT - 1) % HEIGHT];
+            const Row& mid = m_rows[y];
+            const Row& down = m_rows[(y + 1) % HEIGHT];
+            const Row upLeft = RotateLeft(up);
+            const Row upRight = RotateRight(up);
+            const Row midLeft = RotateLeft(mid);
+            const Row midRight = RotateRight(mid);
+            const Row downLeft = RotateLeft(down);
+            const Row downRight = RotateRight(down);
+
+            for (int w = 0; w < WORDS; ++w) {
+                // add up the 8 neighbour bitplanes; b2:b1:b0 is the count
+                // mod 8, which is fine because 8 neighbours and 0 both mean
+                // death
+                Word s0, c0, s1, c1;
+                FullAdd(upLeft[w], up[w], upRight[w], s0, c0);
+                FullAdd(downLeft[w], down[w], downRight[w], s1, c1);
+                const Word s2 = midLeft[w] ^ midRight[w];
+                const Word c2 = midLeft[w] & midRight[w];
+
+                Word b0, c3, twos, c4;
+                FullAdd(s0, s1, s2, b0, c3);
+                FullAdd(c0, c1, c2, twos, c4);
+                const Word b1 = twos ^ c3;
+                const Word b2 = c4 ^ (twos & c3);
+
+                // born with 3 neighbours, survives with 2 or 3
+                next[y][w] = b1 & ~b2 & (b0 | mid[w]);
+            }
+            next[y][WORDS - 1] &= LAST_WORD_MASK;
+        }
+        m_rows = next;
+    }
+
+  private:
+    static void FullAdd(const Word a,
+                        const Word b,
+                        const Word c,
+                        Word& sum,
+                        Word& carry) {
+        sum = a ^ b ^ c;
+        carry = (a & b) | (c & (a ^ b));
+    }
+
+    // cell x moves to x + 1, the last cell wraps around to 0
+    static Row RotateLeft(const Row& row) {
+        Row rotated;
+        Word carry = (row[WORDS - 1] >> LAST_BIT) & 1;
+        for (int w = 0; w < WORDS; ++w) {
+            rotated[w] = (row[w] << 1) | carry;
+            carry = row[w] >> (WORD_BITS - 1);
+        }
+        rotated[WORDS - 1] &= LAST_WORD_MASK;
+        return rotated;
+    }
+
+    // cell x moves to x - 1, cell 0 wraps around to the last one
+    static Row RotateRight(const Row& row) {
+        Row rotated;
+        for (int w = 0; w < WORDS; ++w) {
+            const Word carry =
+                w + 1 < WORDS ? row[w + 1] << (WORD_BITS - 1) : 0;
+            rotated[w] = (row[w] >> 1) | carry;
+        }
+        rotated[WORDS - 1] |= (row[0] & 1) << LAST_BIT;
+        return rotated;
+    }
+
+    std::array<Row, HEIGHT> m_rows{};
+};
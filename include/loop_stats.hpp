@@ -0,0 +1,32 @@
+#pragma once
+#include <stdint.h>
+
+// How often the main loop goes around, and how much of the time it's busy
+// rather than waiting (or sleeping) until the next event.
+class LoopStats {
+  public:
+    void AddIteration(const uint32_t busyUs, const uint32_t waitUs) {
+        ++m_iterations;
+        m_busyUs += busyUs;
+        m_waitUs += waitUs;
+    }
+
+    uint32_t GetIterations() const { return m_iterations; }
+
+    float GetIterationsPerSecond() const {
+        const uint64_t totalUs = m_busyUs + m_waitUs;
+        return totalUs ? m_iterations * 1000000.0f / totalUs : 0;
+    }
+
+    float GetBusyPercent() const {
+        const uint64_t totalUs = m_busyUs + m_waitUs;
+        return totalUs ? m_busyUs * 100.0f / totalUs : 0;
+    }
+
+    void Reset() { *this = LoopStats(); }
+
+  private:
+    uint32_t m_iterations{0};
+    uint64_t m_busyUs{0};
+    uint64_t m_waitUs{0};
+};
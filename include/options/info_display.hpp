@@ -39,6 +39,8 @@ class InfoDisplay : public Display {
     std::shared_ptr<Animator> m_demoAnim;
     uint8_t m_demoAnimSelection{ANIM_NORMAL};
 
+    std::unique_ptr<Breakout> m_game;  // while it's being played
+
   public:
     InfoDisplay() : Display() {
         m_name = "INFO";
@@ -52,6 +54,14 @@ class InfoDisplay : public Display {
     }
 
     virtual void Update() override {
+        if (m_game && m_game->IsDone()) {
+            m_game.reset();
+        }
+        if (m_game) {
+            m_game->Update();
+            return;
+        }
+
 #if FCOS_ESP32_C3
         if (m_isBME680Present && m_sinceLastSensorData.Ms() > 250) {
             m_sinceLastSensorData.Reset();
@@ -114,6 +124,9 @@ class InfoDisplay : public Display {
     }
 
     virtual void Up(const Button::Event_e evt) override {
+        if (m_game) {
+            return;
+        }
         if (evt == Button::PRESS || evt == Button::REPEAT) {
             if (m_type < INFO_TOTAL - 1) {
                 m_type++;
@@ -121,17 +134,25 @@ class InfoDisplay : public Display {
         }
     }
     virtual void Down(const Button::Event_e evt) override {
+        if (m_game) {
+            return;
+        }
         if (evt == Button::PRESS || evt == Button::REPEAT) {
             if (m_type > 0) {
                 m_type--;
             } else if (m_type == 0) {
-                Breakout game(m_pixels, m_settings, m_rtc);
-                game.Start();
+                m_game.reset(new Breakout(m_pixels, m_settings, m_rtc));
             }
         }
     }
 
-    // any left/right button press will exit this display
+    // any left/right button press will exit this display, or the game
+    virtual bool Left(const Button::Event_e evt) override {
+        return m_game ? m_game->Left(evt) : false;
+    }
+    virtual bool Right(const Button::Event_e evt) override {
+        return m_game != nullptr;
+    }
 
     virtual bool ShouldTimeout() override { return false; }
 };
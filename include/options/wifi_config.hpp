@@ -1,20 +1,95 @@
 #pragma once
 #include <WiFiManager.h>
+#include <coroutine.hpp>
 #include <elapsed_time.hpp>
 #include <memory>
 #include <options/numeric.hpp>
+#include <timezones.hpp>
 
 class WiFiConfig : public Numeric {
     enum {
         BOOT_INIT_WAIT_MS = 2000,
+        CONNECTED_BLINK_MS = 75,
+        CONNECTED_ANIM_MS = 1000,
     };
 
+    // once the portal has saved, shows that WiFi is connected, a frame at a
+    // time from Update() rather than blocking inside the portal's callback
+    class ConnectedAnimation : public Coroutine {
+      public:
+        ConnectedAnimation(WiFiConfig& config) : m_config(config) {}
+
+      protected:
+        WiFiConfig& m_config;
+        uint32_t m_beginMs{0};
+        int m_textX{0};
+        int m_textWidth{0};
+
+        virtual void Run() override {
+            CO_BEGIN();
+            m_beginMs = m_coNowMs;
+#if FCOS_FOXIECLOCK
+            while (m_coNowMs - m_beginMs < CONNECTED_ANIM_MS) {
+                m_config.m_pixels->Set(41, IsLedOn() ? GREEN : BLACK);
+                m_config.m_pixels->Set(40, IsLedOn() ? GREEN : BLACK);
+                CO_YIELD();
+            }
+#elif FCOS_CARDCLOCK || FCOS_CARDCLOCK2
+            // as DrawTextScrolling() does, but moving with the time
+            m_textWidth = m_config.m_pixels->DrawText(0, TEXT, GREEN);
+            for (m_textX = Pixels::Shape::WIDTH; m_textX > -m_textWidth;
+                 m_textX = Pixels::Shape::WIDTH -
+                           (int)((m_coNowMs - m_beginMs) / SCROLLING_TEXT_MS)) {
+                m_config.m_pixels->Clear();
+#if FCOS_CARDCLOCK2
+                m_config.m_pixels->DrawText(m_textX, 3, TEXT, GREEN);
+#else
+                m_config.m_pixels->DrawText(m_textX, 0, TEXT, GREEN);
+#endif
+                CO_YIELD();
+            }
+#endif
+            CO_END();
+        }
+
+        bool IsLedOn() const {
+            return ((m_coNowMs - m_beginMs) / CONNECTED_BLINK_MS) % 2 == 0;
+        }
+
+        static constexpr const char* TEXT = "WIFI CONNECTED";
+    };
+    std::unique_ptr<ConnectedAnimation> m_connected;
+
     std::shared_ptr<WiFiManager> m_wifiMgr;
     ElapsedTime m_wifiLedAnim;
     bool m_isInitialized{false};
 
-    char m_timeZonesHtml[2048] = {0};
-    WiFiManagerParameter m_setupHtmlParam{m_timeZonesHtml};
+    // the timezone names are too big to go in the page, which WiFiManager
+    // builds in RAM, so the page loads them from /tz.js, which is sent
+    // straight from the table in flash (see SendTimeZoneNames())
+    static constexpr const char* TIMEZONE_HTML = R"(
+            <br/>
+            <label for='tz_select'>Select Timezone (Note: only affects clock when on WiFi):</label>
+            <select name="tz_select" id="tz_select" class="button"></select>
+            <script src="/tz.js"></script>
+            <script>
+            function tzSelect(names, selected) {
+                var select = document.getElementById("tz_select");
+                var region = "";
+                names.split(" ").forEach(function(name, i) {
+                    if (name[0] == "/") {
+                        name = region + name;
+                    } else {
+                        region = name.split("/")[0];
+                    }
+                    select.add(new Option(name.replace(/_/g, " "), i, false,
+                                          i == selected));
+                });
+            }
+            </script>)";
+    char m_timeZoneSelectedHtml[48] = {0};
+    WiFiManagerParameter m_timeZoneHtmlParam{TIMEZONE_HTML};
+    WiFiManagerParameter m_timeZoneSelectedParam{m_timeZoneSelectedHtml};
 
   public:
     // 0 = off, 1 = on, 2 = show config portal
@@ -65,6 +140,10 @@ class WiFiConfig : public Numeric {
         } else {
             AllowChangingValues(true);
         }
+
+        if (m_connected && !m_connected->Resume(millis())) {
+            m_connected.reset();
+        }
     }
 
     virtual void Down(const Button::Event_e evt) override {
@@ -100,7 +179,7 @@ class WiFiConfig : public Numeric {
     }
 
     virtual bool ShouldTimeout() override {
-        return !m_wifiMgr->getConfigPortalActive();
+        return !m_wifiMgr->getConfigPortalActive() && !m_connected;
     }
 
   private:
@@ -146,31 +225,13 @@ class WiFiConfig : public Numeric {
         m_wifiMgr->setSaveConfigCallback([&]() {
             (*m_settings)["WIFI"] = "1";
             (*m_settings)["wifi_configured"] = "1";
-            Activate();
-            Update();
-
-#if FCOS_FOXIECLOCK
-            ElapsedTime successAnim;
-            bool isLedOn = true;
-            while (successAnim.Ms() < 1000) {
-                m_pixels->Set(41, isLedOn ? GREEN : BLACK);
-                m_pixels->Set(40, isLedOn ? GREEN : BLACK);
-                isLedOn = !isLedOn;
-                m_pixels->Update();
-                ElapsedTime::Delay(75);
-            }
-#elif FCOS_CARDCLOCK || FCOS_CARDCLOCK2
-            m_pixels->DrawTextScrolling("WIFI CONNECTED", GREEN);
-#endif
             (*m_settings).Save();
+            Activate();
+            m_connected.reset(new ConnectedAnimation(*this));
         });
         m_wifiMgr->setSaveParamsCallback([&]() {
             // do stuff with the params (timezone)
-            auto names = m_rtc->GetTimezoneNames();
-            size_t selected = GetHttpParam("tz_select").toInt();
-            selected = selected > 0 && selected < names.size() ? selected : 0;
-            (*m_settings)["timezone"] = names[selected];
-            (*m_settings)["TIMEZONE"] = selected;
+            m_rtc->SetTimezone(GetHttpParam("tz_select").toInt());
             m_rtc->ForceNTPUpdate();
             SetupTimeZoneHtml();
         });
@@ -178,28 +239,27 @@ class WiFiConfig : public Numeric {
         std::vector<const char*> menu = {"param", "wifi", "sep", "exit"};
         m_wifiMgr->setMenu(menu);
         SetupTimeZoneHtml();
-        m_wifiMgr->addParameter(&m_setupHtmlParam);
+        m_wifiMgr->addParameter(&m_timeZoneHtmlParam);
+        m_wifiMgr->addParameter(&m_timeZoneSelectedParam);
+        m_wifiMgr->setWebServerCallback([&]() {
+            m_wifiMgr->server->on("/tz.js", [&]() { SendTimeZoneNames(); });
+        });
     }
 
     void SetupTimeZoneHtml() {
-        String html = R"(
-            <br/>
-            <label for='tz_select'>Select Timezone (Note: only affects clock when on WiFi):</label>
-            <select name="tz_select" id="tz_select" class="button">
-            )";
-
-        auto names = m_rtc->GetTimezoneNames();
-        size_t index = 0;
-        for (const auto& name : names) {
-            html += "<option value='" + String(index) + "'";
-            if ((*m_settings)["TIMEZONE"].as<size_t>() == index) {
-                html += " selected";
-            }
-            html += ">" + name + "</option>";
-            index++;
-        }
-        html += "</select>";
+        sprintf(m_timeZoneSelectedHtml,
+                "<script>tzSelect(tzNames, %d);</script>",
+                m_rtc->GetTimezone());
+    }
 
-        strcpy(m_timeZonesHtml, html.c_str());
+    // streams the ~6KB of names from flash, a chunk at a time
+    void SendTimeZoneNames() {
+        auto& server = *m_wifiMgr->server;
+        server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+        server.send(200, "application/javascript", "");
+        server.sendContent("var tzNames = \"");
+        server.sendContent_P(Timezones::PackedNames());
+        server.sendContent("\";");
+        server.sendContent("");  // the end of the chunked response
     }
 };
\ No newline at end of file
@@ -0,0 +1,99 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <array>
+
+// The lookup tables behind Palette, apart from NeoPixelBus so that they can
+// be tested on the host. Color is anything with R, G and B channels and an
+// (r, g, b) constructor, i.e. RgbColor in the firmware.
+//
+// A palette is stored as 16 colors evenly spaced around a 0-255 wheel, the
+// last of which blends back into the first, and expanded into a 256 entry
+// lookup table when it's selected. Looking a color up is then just as cheap
+// as a hue, whichever palette is active.
+template <typename Color>
+class BasicPalette {
+  public:
+    enum {
+        NUM_STOPS = 16,
+        LUT_SIZE = 256,
+        STOP_SPACING = LUT_SIZE / NUM_STOPS,
+    };
+
+    using Stops = std::array<uint32_t, NUM_STOPS>;  // 0xRRGGBB
+    using Lut = std::array<Color, LUT_SIZE>;
+
+    static Lut Expand(const Stops& stops) {
+        Lut lut;
+        for (size_t stop = 0; stop < NUM_STOPS; ++stop) {
+            const uint32_t a = stops[stop];
+            const uint32_t b = stops[(stop + 1) % NUM_STOPS];
+            const Color from(a >> 16, (a >> 8) & 0xFF, a & 0xFF);
+            const Color to(b >> 16, (b >> 8) & 0xFF, b & 0xFF);
+            for (size_t i = 0; i < STOP_SPACING; ++i) {
+                lut[stop * STOP_SPACING + i] =
+                    Lerp(from, to, i * LUT_SIZE / STOP_SPACING);
+            }
+        }
+        return lut;
+    }
+
+    // exactly the colors of HslColor(i / 255.0f, 1.0f, 0.5f), which is what
+    // the hue wheel always was. 16 stops interpolated in RGB would dull it
+    // between the primaries
+    static Lut Rainbow() {
+        Lut lut;
+        for (size_t i = 0; i < LUT_SIZE; ++i) {
+            const float hue = i / 255.0f;
+            lut[i] = Color((uint8_t)(HueChannel(hue + 1.0f / 3.0f) * 255),
+                           (uint8_t)(HueChannel(hue) * 255),
+                           (uint8_t)(HueChannel(hue - 1.0f / 3.0f) * 255));
+        }
+        return lut;
+    }
+
+    // pos is 8.8 fixed point, so slow gradients don't visibly step from
+    // one entry to the next
+    static Color Sample(const Lut& lut, const uint16_t pos) {
+        const uint8_t i = pos >> 8;
+        return Lerp(lut[i], lut[(uint8_t)(i + 1)], pos & 0xFF);
+    }
+
+    // amount is 0 (all |from|) to 255 (almost all |to|)
+    static void Blend(const Lut& from,
+                      const Lut& to,
+                      const uint8_t amount,
+                      Lut& lut) {
+        for (size_t i = 0; i < LUT_SIZE; ++i) {
+            lut[i] = Lerp(from[i], to[i], amount);
+        }
+    }
+
+  private:
+    static Color Lerp(const Color& a, const Color& b, const uint8_t f) {
+        return Color(a.R + (((b.R - a.R) * f) >> 8),
+                     a.G + (((b.G - a.G) * f) >> 8),
+                     a.B + (((b.B - a.B) * f) >> 8));
+    }
+
+    // one channel of a fully saturated HSL color with 50% lightness, the
+    // same steps as NeoPixelBus' HslColor conversion
+    static float HueChannel(float t) {
+        if (t < 0.0f) {
+            t += 1.0f;
+        }
+        if (t > 1.0f) {
+            t -= 1.0f;
+        }
+        if (t < 1.0f / 6.0f) {
+            return 6.0f * t;
+        }
+        if (t < 0.5f) {
+            return 1.0f;
+        }
+        if (t < 2.0f / 3.0f) {
+            return (2.0f / 3.0f - t) * 6.0f;
+        }
+        return 0.0f;
+    }
+};
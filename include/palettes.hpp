@@ -0,0 +1,23 @@
+#pragma once
+#include <NeoPixelBus.h>  // for RgbColor
+#include <palette_lut.hpp>
+
+// The palettes that can be selected with the PAL setting (1-based there)
+enum Palette_e {
+    PALETTE_RAINBOW,  // the full saturation hue wheel
+    PALETTE_CANDLE,   // deep reds through amber to warm white
+    PALETTE_OCEAN,
+    PALETTE_FOREST,
+    PALETTE_PASTEL,
+    PALETTE_ICE,
+
+    PALETTE_TOTAL,
+};
+
+// The built-in palettes as RgbColor lookup tables, see BasicPalette
+class Palette : public BasicPalette<RgbColor> {
+  public:
+    using BasicPalette::Expand;
+
+    static Lut Expand(const Palette_e palette);
+};
@@ -0,0 +1,88 @@
+#pragma once
+#include <stdint.h>
+
+#include <civil_time.hpp>
+
+// The PCF8563's seven time and date registers (0x02-0x08), which are read
+// in a single burst so they can't roll over part way through, and the
+// software clock (and calendar) that runs on the 1Hz interrupt between
+// reads.
+struct Pcf8563Time {
+    enum {
+        FIRST_REGISTER = 0x02,
+        NUM_REGISTERS = 7,
+    };
+
+    uint8_t second{0};
+    uint8_t minute{0};
+    uint8_t hour{0};
+    uint8_t day{1};
+    uint8_t weekday{0};
+    uint8_t month{1};
+    uint16_t year{2000};
+    bool voltageLow{false};  // the clock stopped at some point, e.g. no battery
+
+    // false if any register isn't valid BCD or is out of range, as happens
+    // when the bus glitches or the RTC hasn't started yet (it reports 33h)
+    static bool Decode(const uint8_t (&regs)[NUM_REGISTERS], Pcf8563Time& t) {
+        uint8_t second, minute, hour, day, month, year;
+        if (!FromBcd(regs[0] & 0x7F, second) || second > 59 ||
+            !FromBcd(regs[1] & 0x7F, minute) || minute > 59 ||
+            !FromBcd(regs[2] & 0x3F, hour) || hour > 23 ||
+            !FromBcd(regs[3] & 0x3F, day) || day < 1 || day > 31 ||
+            (regs[4] & 0x07) > 6 ||
+            !FromBcd(regs[5] & 0x1F, month) || month < 1 || month > 12 ||
+            !FromBcd(regs[6], year)) {
+            return false;
+        }
+        t.second = second;
+        t.minute = minute;
+        t.hour = hour;
+        t.day = day;
+        t.weekday = regs[4] & 0x07;
+        t.month = month;
+        // the century bit means 19xx, as Rtc_Pcf8563 sets it
+        t.year = ((regs[5] & 0x80) ? 1900 : 2000) + year;
+        t.voltageLow = regs[0] & 0x80;
+        return true;
+    }
+
+    // seconds since 1970-01-01 00:00, as if this were UTC
+    int64_t Epoch() const {
+        return CivilTime::DaysFromCivil(year, month, day) * CivilTime::DAY_S +
+               hour * 3600 + minute * 60 + second;
+    }
+
+    void SetEpoch(const int64_t epoch) {
+        const int64_t days = CivilTime::DaysFromEpoch(epoch);
+        int64_t y;
+        int m, d;
+        CivilTime::CivilFromDays(days, y, m, d);
+        year = y;
+        month = m;
+        day = d;
+        weekday = CivilTime::WeekdayFromDays(days);
+        const int32_t secondOfDay = epoch - days * CivilTime::DAY_S;
+        hour = secondOfDay / 3600;
+        minute = secondOfDay / 60 % 60;
+        second = secondOfDay % 60;
+    }
+
+    // moves the time on, for the seconds counted by the interrupt
+    void AdvanceSeconds(const uint32_t seconds) {
+        if (second + seconds < 60) {
+            second += seconds;  // the usual case, no need for the calendar
+        } else {
+            SetEpoch(Epoch() + seconds);
+        }
+    }
+
+  private:
+    static bool FromBcd(const uint8_t bcd, uint8_t& value) {
+        if ((bcd & 0x0F) > 9 || (bcd >> 4) > 9) {
+            return false;
+        }
+        value = (bcd >> 4) * 10 + (bcd & 0x0F);
+        return true;
+    }
+};
@@ -0,0 +1,32 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <algorithm>  // for std::min
+#include <cmath>      // for powf
+
+// The per-channel arithmetic behind Pixels, apart from NeoPixelBus so that
+// it can be tested on the host. Scales are 16.16 fixed point.
+struct PixelMath {
+    enum : uint32_t {
+        UNITY = 65536,  // a scale of 1.0
+    };
+
+    // |channel| times |scale|, which can be above 1.0, saturating at 255
+    static uint8_t ScaleChannel(const uint8_t channel, const uint32_t scale) {
+        return std::min<uint64_t>(((uint64_t)channel * scale) >> 16, 255);
+    }
+
+    // |channel| times |gain| times |scale| with a single rounding, e.g. an
+    // LED's gain and a scale for the whole frame
+    static uint8_t ScaleChannel(const uint8_t channel,
+                                const uint32_t gain,
+                                const uint32_t scale) {
+        return std::min<uint64_t>(
+            ((uint64_t)channel * gain * scale) >> 32, 255);
+    }
+
+    // scaling by |amount| |numTimes| in a row, as a single scale
+    static uint32_t RepeatedScale(const float amount, const size_t numTimes) {
+        return UNITY * powf(std::max(0.0f, std::min(amount, 1.0f)), numTimes);
+    }
+};
@@ -2,10 +2,18 @@
 #include <NeoPixelBus.h>  // for communication with LEDs
 #include <vector>         // for std::vector (primarily for characters/*.inc)
 
+#include <display_defaults.hpp>
 #include <dprint.hpp>
 #include <elapsed_time.hpp>
+#include <frame_stats.hpp>
+#include <geometry.hpp>
+#include <led_outputs.hpp>
 #include <light_sensor.hpp>
+#include <palettes.hpp>
+#include <pixel_math.hpp>
 #include <settings.hpp>
+#include <trail_buffer.hpp>
+#include <white_point.hpp>
 
 static RgbColor BLACK(0, 0, 0);
 static RgbColor WHITE(255, 255, 255);
@@ -47,46 +55,34 @@ enum ScrollDirection_e {
 };
 
 enum PixelsConfig_e {
-
 #if FCOS_FOXIECLOCK
-    DISPLAY_WIDTH = 20 + 20 + 2 /* blinkers */ + 20 + 20,
-    DISPLAY_HEIGHT = 1,
     CHAR_DISPLAY_HEIGHT = 20,
-    OPTION_LEDS = 8 + 2,
-    NUM_RINGS = 0,
     SCROLL_DELAY_HORIZONTAL_MS = 8,
     SCROLL_DELAY_VERTICAL_MS = 8,
-#elif FCOS_CARDCLOCK
-    DISPLAY_WIDTH = 17,
-    DISPLAY_HEIGHT = 5,
-    CHAR_DISPLAY_HEIGHT = 5,
-    OPTION_LEDS = 0,
-    NUM_RINGS = 2,
-    SCROLL_DELAY_HORIZONTAL_MS = 10,
-    SCROLL_DELAY_VERTICAL_MS = 20,
-#elif FCOS_CARDCLOCK2
-    DISPLAY_WIDTH = 17,
-    DISPLAY_HEIGHT = 11,
+#elif FCOS_CARDCLOCK || FCOS_CARDCLOCK2
     CHAR_DISPLAY_HEIGHT = 5,
-    OPTION_LEDS = 0,
-    NUM_RINGS = 3,
     SCROLL_DELAY_HORIZONTAL_MS = 10,
     SCROLL_DELAY_VERTICAL_MS = 20,
 #endif
-    RING_SIZE = 12,
-    ROUND_LEDS = RING_SIZE * NUM_RINGS,
-
     CHAR_HEIGHT = 5,
-    TOTAL_MATRIX_LEDS = DISPLAY_WIDTH * DISPLAY_HEIGHT,
-    FIRST_RING_LED = TOTAL_MATRIX_LEDS,
-    TOTAL_ALL_LEDS = TOTAL_MATRIX_LEDS + ROUND_LEDS + OPTION_LEDS,
 
     SCROLLING_TEXT_MS = 50,
-    FRAMES_PER_SECOND = 30,
     LIGHT_SENSOR_UPDATE_MS = 33,
-
-    MIN_DISPLAY_BRIGHTNESS_DEFAULT = 1,
-    MAX_DISPLAY_BRIGHTNESS = 9,
+    PALETTE_BLEND_MS = 1000,  // cross-fade time when PAL changes
+
+    // for estimating the current the LEDs draw (WS2812 datasheet values)
+    LED_CHANNEL_MA = 20,  // one channel at 255
+    LED_IDLE_UA = 600,    // an LED that's off
+    // the most a 500mA USB port can give the LEDs after the ESP32 and
+    // WiFi, a bigger supply can opt in to more with the PWR_MA setting
+    POWER_BUDGET_MA_DEFAULT = 400,
+    POWER_SCALE_STEP = PixelMath::UNITY / 64,  // smallest change once dimmed
+
+    // WARM picks how warm white gets at night, in steps down from daylight
+    MAX_WARMTH = 9,
+    WARMTH_STEP_K = (WhitePoint::DAYLIGHT_K - WhitePoint::MIN_K) / MAX_WARMTH,
+    WHITE_POINT_MINUTES = 10,  // how often the time can change the white point
+    WHITE_POINT_LIGHT_STEPS = 8,
 };
 
 enum LEDOptionPositions_e {
@@ -103,7 +99,11 @@ enum LEDOptionPositions_e {
     LED_UNUSED = 0xFFFF,
 };
 
-class Pixels {
+// Pixels is BasicPixels<ActiveGeometry>, see the end of this file. The
+// Geometry is a template parameter so that the logical-to-chain mapping is
+// a constant table lookup for every LED.
+template <typename Geometry>
+class BasicPixels {
   private:
 #if FCOS_ESP32_C3
     // Note: NeoPixelBus' Tx1812 timing seems to cause more glitches with
@@ -118,23 +118,138 @@ class Pixels {
     //                           in the ESP core for this kind of use
     //                           on channel 0
     // NeoEsp32Rmt1Ws2812xMethod flickers less often
-    NeoPixelBus<NeoGrbFeature, NeoEsp32BitBangWs2812xMethod> m_neoPixels;
+    //
+    // Bit-banging blocks until the chain is sent, though, so geometries
+    // with several outputs use one RMT channel per output instead (the
+    // ESP32-C3 has 2 TX channels), which all send at the same time.
+    using Bus = std::conditional_t<
+        Geometry::NUM_OUTPUTS == 1,
+        NeoPixelBus<NeoGrbFeature, NeoEsp32BitBangWs2812xMethod>,
+        NeoPixelBus<NeoGrbFeature, NeoEsp32RmtNWs2812xMethod>>;
 
 #elif FCOS_ESP8266
-    NeoPixelBus<NeoGrbFeature, NeoEsp8266BitBang800KbpsMethod> m_neoPixels;
+    using Bus = NeoPixelBus<NeoGrbFeature, NeoEsp8266BitBang800KbpsMethod>;
+    static_assert(Geometry::NUM_OUTPUTS == 1,
+                  "the ESP8266 only drives a single output");
 #endif
+    LedOutputs<Geometry, Bus> m_outputs;
     std::shared_ptr<Settings> m_settings;
     LightSensor m_lightSensor;
     float m_currentBrightness{-1};
     float m_adjustedBrightness{-1};
+    int m_maxBrightness{MAX_DISPLAY_BRIGHTNESS};  // set by a power profile
 
     ElapsedTime m_sinceLastLightSensorUpdate;
 
     bool m_isPXLmode{false};
     bool m_useDarkMode{false};
 
+    // R + G + B of each LED and of the whole frame, kept up to date by
+    // SetLED() so that Show() can estimate the current without a pass over
+    // the LEDs
+    std::vector<uint16_t> m_channelSums;
+    uint32_t m_frameChannelSum{0};
+    uint32_t m_powerBudgetMa{POWER_BUDGET_MA_DEFAULT};
+    uint32_t m_powerClampCount{0};
+    // 16.16, multiplied in with each LED's gain as it's drawn, so that
+    // frames are drawn within the budget instead of being dimmed afterwards
+    uint32_t m_powerScale{PixelMath::UNITY};
+
+    // the circadian white point, folded into the gain table. It's only
+    // recalculated when the time or light moves into another step.
+    WhitePoint m_whitePoint;
+    int m_whitePointStep{-1};
+    int m_minuteOfDay{12 * 60};
+
+    FrameStats m_frameStats;
+    std::vector<uint8_t> m_lastFrame;  // as sent, in each bus' byte order
+    uint32_t m_lastFrameChanged{0};    // see LedOutputs::DiffFrame()
+
+    // the active palette, which ColorWheel() samples. While the PAL setting
+    // changes it cross-fades from the old palette to the new one.
+    inline static Palette::Lut s_palette = Palette::Expand(PALETTE_RAINBOW);
+    Palette::Lut m_paletteFrom;
+    Palette::Lut m_paletteTo;
+    int m_palette{PALETTE_RAINBOW};
+    bool m_isBlendingPalette{false};
+    ElapsedTime m_sincePaletteChange;
+
+  public:
+    // renderers size themselves from this rather than from ActiveGeometry,
+    // so they follow whichever panel they are drawing on
+    using Shape = Geometry;
+
+    // a single output is bit-banged, which counts out its bit timing in CPU
+    // cycles worked out from F_CPU at compile time, so the CPU frequency
+    // can't change under it. The RMT has its own clock
+    enum { IS_CPU_TIMED = Geometry::NUM_OUTPUTS == 1 };
+
+    // an off-screen copy of the matrix LEDs, e.g. for cross-fading between
+    // two animators that each draw into their own Buffer
+    using Buffer = std::vector<RgbColor>;
+
+    // A persistent copy of the matrix for trail effects. Whatever is drawn
+    // into it fades by itself with the layer's half-life, measured in real
+    // time, so trails are the same length at any frame rate. The channels
+    // are a TrailBuffer (see trail_buffer.hpp).
+    class Layer : public TrailBuffer<Geometry::WIDTH, Geometry::HEIGHT> {
+      public:
+        explicit Layer(const uint16_t halfLifeMs);
+
+        void SetHalfLife(const uint16_t halfLifeMs);
+
+        void Set(const int x, const int y, const RgbColor color);
+
+        // |color| at a fractional position, see TrailBuffer::Splat()
+        void Splat(const float x, const float y, const RgbColor color);
+
+        RgbColor Get(const int pos) const;
+
+      private:
+        friend class BasicPixels;
+
+        using Trail = TrailBuffer<Geometry::WIDTH, Geometry::HEIGHT>;
+
+        uint16_t m_halfLifeMs;
+        ElapsedTime m_sinceDecay;
+    };
+
+    // Per-LED corrections for units whose LEDs or acrylics don't match.
+    // They're folded into the gain table whenever the brightness changes,
+    // so they cost nothing extra per pixel.
+    enum {
+        CALIBRATION_UNITY = 128,  // a gain of 1.0
+    };
+
+    struct Calibration {
+        uint8_t r{CALIBRATION_UNITY};
+        uint8_t g{CALIBRATION_UNITY};
+        uint8_t b{CALIBRATION_UNITY};
+        // how much brighter an edge-lit LED needs to be to shine through
+        // its acrylic, on top of the display brightness
+        uint8_t edgeBoost{0};
+    };
+
+  private:
+    Buffer* m_renderTarget{nullptr};
+    Layer* m_layerTarget{nullptr};
+
+    std::vector<Calibration> m_calibration;
+    // R, G, B gain for each LED in 16.16 fixed point: the display brightness
+    // and edge-lit boost times the calibration
+    std::vector<uint32_t> m_gain;
+    // what m_gain was last built from, so that the light sensor only
+    // rebuilds it when the brightness actually changes
+    struct GainInputs {
+        float adjustedBrightness{-1};
+        float brightness{-1};
+        int whitePointStep{-1};
+        bool isPXLmode{false};
+        bool useDarkMode{false};
+    } m_gainInputs;
+
   public:
-    Pixels(std::shared_ptr<Settings> settings);
+    BasicPixels(std::shared_ptr<Settings> settings);
 
     void Update();
 
@@ -166,7 +281,14 @@ class Pixels {
     int DrawChar(int x, int y, char character, const RgbColor color);
     int DrawChar(int x, int y, char character, const RgbColor beginColor, const RgbColor endColor);
 
-    static RgbColor ColorWheel(uint8_t pos);
+    // the color at |pos| on the active palette (see palettes.hpp), which
+    // is the hue wheel unless PAL selects another one
+    static RgbColor ColorWheel(uint8_t pos) { return s_palette[pos]; }
+
+    // the same, with pos in 8.8 fixed point to blend between entries
+    static RgbColor PaletteColor(const uint16_t pos) {
+        return Palette::Sample(s_palette, pos);
+    }
 
     float GetBrightness();
 
@@ -181,6 +303,29 @@ class Pixels {
 
     bool IsDarkModeEnabled();
 
+    bool IsPXLModeEnabled();
+
+    // for the circadian white point, see the WARM setting
+    void SetTimeOfDay(const int hour, const int minute);
+
+    // caps the brightness the light sensor can take the LEDs to, out of
+    // MAX_DISPLAY_BRIGHTNESS (which doesn't cap it)
+    void SetMaxBrightness(const int maxBrightness);
+
+    // what the LEDs will draw once the current frame is shown
+    uint32_t GetEstimatedCurrentMa() const;
+
+    // how many frames have been dimmed to stay within the PWR_MA budget
+    uint32_t GetPowerClampCount() const { return m_powerClampCount; }
+
+    // what each Display/Animator does to the LEDs, see frame_stats.hpp.
+    // Whatever draws sets the bucket before the frame is shown.
+    FrameStats& GetFrameStats() { return m_frameStats; }
+
+    // how many LEDs the last frame that was shown changed, or just 1 if it
+    // changed any while the frame stats are off
+    uint32_t GetLastFrameChanged() const { return m_lastFrameChanged; }
+
     void DrawColorWheelBetween(uint8_t wheelPos,
                                const size_t x1,
                                const size_t x2);
@@ -221,6 +366,103 @@ class Pixels {
 
     void MoveVertical(const int num);
 
+    // while a render target is set, Set() and Darken() only affect the
+    // matrix LEDs stored in that buffer. nullptr draws to the LEDs again.
+    void SetRenderTarget(Buffer* target);
+
+    // while a layer target is set, Set() and Shade() draw the matrix LEDs
+    // into |layer| instead, before the brightness scaling, for ComposeLayer()
+    // to put on the LEDs. nullptr draws to the LEDs again.
+    void SetLayerTarget(Layer* layer);
+
+    void CopyMatrixTo(Buffer& buffer);
+
+    // amount: 0 = only |from|, 255 = only |to|
+    void BlendMatrix(const Buffer& from, const Buffer& to, const uint8_t amount);
+
+    Calibration GetCalibration(const int pos);
+
+    void SetCalibration(const int pos, const Calibration& calibration);
+
+    // back to the built-in calibration, which is the same for every unit
+    void ResetCalibration();
+
+    bool SaveCalibration();
+
+    // writes |layer| to every matrix LED, then fades it by the time since the
+    // previous call in the same pass. Call this once per frame per layer.
+    void ComposeLayer(Layer& layer);
+
+    // Fills every matrix LED with shader(x, y, t, params) (see shaders.hpp).
+    // The shader is a template parameter so it is inlined into this loop.
+    template <typename Shader, typename Params>
+    void Shade(const Shader& shader, const uint32_t t, const Params& params) {
+        RgbColor* target = m_renderTarget ? m_renderTarget->data() : nullptr;
+        const uint32_t* gain = m_gain.data();
+        const uint32_t power = m_powerScale;
+        int pos = 0;
+        for (int y = 0; y < Geometry::HEIGHT; ++y) {
+            for (int x = 0; x < Geometry::WIDTH; ++x, ++pos, gain += 3) {
+                const RgbColor c = shader(x, y, t, params);
+                if (m_layerTarget) {
+                    m_layerTarget->Set(x, y, c);
+                    continue;
+                }
+                // calibration gains above 1.0 can push a channel past 255
+                const RgbColor scaled(
+                    PixelMath::ScaleChannel(c.R, gain[0], power),
+                    PixelMath::ScaleChannel(c.G, gain[1], power),
+                    PixelMath::ScaleChannel(c.B, gain[2], power));
+                if (target) {
+                    target[pos] = scaled;
+                } else {
+                    SetLED(pos, scaled);
+                }
+            }
+        }
+    }
+
   private:
     void SetLEDBrightnessMultiplierFromSensor();
+
+    void LimitPower();
+
+    int GetSelectedPalette();
+
+    void UpdatePalette();
+
+    void LoadCalibration();
+
+    bool UpdateWhitePoint();
+
+    // whether anything UpdateGainTable() depends on, apart from the
+    // calibration, has changed since it last ran
+    bool IsGainTableStale() const;
+
+    void UpdateGainTable();
+
+    void SetPixelColor(const int pos, const RgbColor color);
+
+    static std::unique_ptr<Bus> MakeBus(const int output,
+                                        const uint16_t numLEDs);
+
+    // pos is a logical position, which the Geometry maps onto the chain
+    void SetLED(const int pos, const RgbColor color) {
+        if (pos >= 0 && pos < Geometry::TOTAL_LEDS) {
+            const uint16_t sum = color.R + color.G + color.B;
+            m_frameChannelSum += sum - m_channelSums[pos];
+            m_channelSums[pos] = sum;
+            m_frameStats.CountWrite();
+            m_outputs.SetPixelColor(Geometry::CHAIN[pos], color);
+        }
+    }
+
+    RgbColor GetLED(const int pos) {
+        if (pos < 0 || pos >= Geometry::TOTAL_LEDS) {
+            return BLACK;
+        }
+        return m_outputs.GetPixelColor(Geometry::CHAIN[pos]);
+    }
 };
+
+using Pixels = BasicPixels<ActiveGeometry>;
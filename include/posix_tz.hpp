@@ -0,0 +1,246 @@
+#pragma once
+#include <stdint.h>
+#include <stdlib.h>  // for strtol()
+#include <time.h>
+#include <algorithm>
+
+#include <civil_time.hpp>
+
+// A timezone from a POSIX TZ string, e.g. "CET-1CEST,M3.5.0,M10.5.0/3", which
+// is what the IANA database reduces each zone to for current and future
+// dates. The UTC offset in effect and when it next changes are cached, so
+// converting is a compare and an add; the rule dates are only worked out
+// again when a transition is crossed, twice a year at most.
+class PosixTz {
+  public:
+    enum : int32_t {
+        HOUR_S = 60 * 60,
+        DAY_S = CivilTime::DAY_S,
+        DEFAULT_TIME_S = 2 * HOUR_S,  // when a rule doesn't say
+    };
+
+    // false if |tz| isn't valid, in which case it's UTC
+    bool Parse(const char* tz) {
+        *this = PosixTz();
+        const char* p = tz;
+        if (!ParseName(p) || !ParseOffset(p, m_stdOffset)) {
+            *this = PosixTz();
+            return false;
+        }
+        m_stdOffset = -m_stdOffset;  // POSIX counts west of UTC as positive
+        if (*p == '\0') {
+            return true;
+        }
+
+        if (!ParseName(p)) {
+            *this = PosixTz();
+            return false;
+        }
+        m_dstOffset = m_stdOffset + HOUR_S;
+        if (*p != ',' && *p != '\0') {
+            if (!ParseOffset(p, m_dstOffset)) {
+                *this = PosixTz();
+                return false;
+            }
+            m_dstOffset = -m_dstOffset;
+        }
+
+        if (*p == '\0') {
+            // no rules given, which means the US ones
+            m_start = {Rule::MONTH_WEEK_DAY, 3, 2, 0, DEFAULT_TIME_S};
+            m_end = {Rule::MONTH_WEEK_DAY, 11, 1, 0, DEFAULT_TIME_S};
+        } else if (*p++ != ',' || !ParseRule(p, m_start) || *p++ != ',' ||
+                   !ParseRule(p, m_end) || *p != '\0') {
+            *this = PosixTz();
+            return false;
+        }
+        m_hasDst = true;
+        return true;
+    }
+
+    time_t ToLocal(const time_t utc) {
+        if (utc < m_validFrom || utc >= m_validUntil) {
+            Recompute(utc);
+        }
+        return utc + m_offset;
+    }
+
+    // as of the last ToLocal()
+    bool IsDst() const { return m_hasDst && m_offset == m_dstOffset; }
+    int32_t GetOffset() const { return m_offset; }  // seconds east of UTC
+    int64_t GetNextTransition() const { return m_validUntil; }
+
+    static int64_t DaysFromCivil(const int64_t y, const int m, const int d) {
+        return CivilTime::DaysFromCivil(y, m, d);
+    }
+
+    static int64_t YearOf(const int64_t t) {
+        int64_t year;
+        int month, day;
+        CivilTime::CivilFromDays(CivilTime::DaysFromEpoch(t), year, month, day);
+        return year;
+    }
+
+  private:
+    struct Rule {
+        enum Kind_e {
+            MONTH_WEEK_DAY,  // Mm.w.d: day d (0 = Sunday) of week w (5 = last)
+            JULIAN_NO_LEAP,  // Jn: day 1-365, never counting February 29th
+            JULIAN,          // n: day 0-365
+        } kind;
+        int month, week, day;
+        int32_t time;  // local time of day, which can be negative or > 24h
+    };
+
+    static bool IsLeap(const int64_t y) {
+        return (y % 4 == 0 && y % 100 != 0) || y % 400 == 0;
+    }
+
+    // when |rule| happens in |year|, as local seconds since the epoch
+    static int64_t LocalTransition(const Rule& rule, const int64_t year) {
+        int64_t days = DaysFromCivil(year, 1, 1);
+        switch (rule.kind) {
+            case Rule::MONTH_WEEK_DAY: {
+                static const int DAYS_IN_MONTH[] = {31, 28, 31, 30, 31, 30,
+                                                    31, 31, 30, 31, 30, 31};
+                const int64_t first = DaysFromCivil(year, rule.month, 1);
+                const int weekday = CivilTime::WeekdayFromDays(first);
+                int day = 1 + (rule.day - weekday + 7) % 7 + (rule.week - 1) * 7;
+                const int length = DAYS_IN_MONTH[rule.month - 1] +
+                                   (rule.month == 2 && IsLeap(year));
+                while (day > length) {
+                    day -= 7;
+                }
+                days = first + day - 1;
+                break;
+            }
+            case Rule::JULIAN_NO_LEAP:
+                days += rule.day - 1 + (IsLeap(year) && rule.day >= 60);
+                break;
+            case Rule::JULIAN:
+                days += rule.day;
+                break;
+        }
+        return days * DAY_S + rule.time;
+    }
+
+    void Recompute(const int64_t utc) {
+        m_offset = m_stdOffset;
+        if (!m_hasDst) {
+            m_validFrom = INT64_MIN;
+            m_validUntil = INT64_MAX;
+            return;
+        }
+
+        // the transitions either side of |utc| are within a year of it
+        struct Transition {
+            int64_t utc;
+            bool isDst;
+        } transitions[6];
+        const int64_t year = YearOf(utc + m_stdOffset);
+        for (int i = 0; i < 3; ++i) {
+            // the start is given in standard time, the end in daylight time
+            transitions[i * 2] = {
+                LocalTransition(m_start, year - 1 + i) - m_stdOffset, true};
+            transitions[i * 2 + 1] = {
+                LocalTransition(m_end, year - 1 + i) - m_dstOffset, false};
+        }
+        std::sort(transitions, transitions + 6,
+                  [](const Transition& a, const Transition& b) {
+                      return a.utc < b.utc;
+                  });
+
+        m_validFrom = INT64_MIN;
+        m_validUntil = INT64_MAX;
+        for (const auto& transition : transitions) {
+            if (transition.utc <= utc) {
+                m_validFrom = transition.utc;
+                m_offset = transition.isDst ? m_dstOffset : m_stdOffset;
+            } else {
+                m_validUntil = transition.utc;
+                break;
+            }
+        }
+    }
+
+    // "CET", or "<+0545>" for names that aren't just letters
+    static bool ParseName(const char*& p) {
+        const char* start = p;
+        if (*p == '<') {
+            while (*p && *p != '>') {
+                p++;
+            }
+            return *p++ == '>' && p - start > 2;
+        }
+        while ((*p >= 'A' && *p <= 'Z') || (*p >= 'a' && *p <= 'z')) {
+            p++;
+        }
+        return p - start >= 3;
+    }
+
+    // [+-]hh[:mm[:ss]], into seconds
+    static bool ParseOffset(const char*& p, int32_t& seconds) {
+        const bool isNegative = *p == '-';
+        if (*p == '+' || *p == '-') {
+            p++;
+        }
+        if (*p < '0' || *p > '9') {
+            return false;
+        }
+        char* end;
+        seconds = strtol(p, &end, 10) * HOUR_S;
+        p = end;
+        for (int32_t unit = 60; unit >= 1 && *p == ':'; unit /= 60) {
+            seconds += strtol(p + 1, &end, 10) * unit;
+            p = end;
+        }
+        seconds = isNegative ? -seconds : seconds;
+        return true;
+    }
+
+    static bool ParseRule(const char*& p, Rule& rule) {
+        char* end;
+        if (*p == 'M') {
+            rule.kind = Rule::MONTH_WEEK_DAY;
+            rule.month = strtol(p + 1, &end, 10);
+            if (*end != '.') {
+                return false;
+            }
+            rule.week = strtol(end + 1, &end, 10);
+            if (*end != '.') {
+                return false;
+            }
+            rule.day = strtol(end + 1, &end, 10);
+            if (rule.month < 1 || rule.month > 12 || rule.week < 1 ||
+                rule.week > 5 || rule.day < 0 || rule.day > 6) {
+                return false;
+            }
+        } else if (*p == 'J' || (*p >= '0' && *p <= '9')) {
+            rule.kind = *p == 'J' ? Rule::JULIAN_NO_LEAP : Rule::JULIAN;
+            rule.day = strtol(*p == 'J' ? p + 1 : p, &end, 10);
+            if (rule.day < (rule.kind == Rule::JULIAN_NO_LEAP) ||
+                rule.day > 365) {
+                return false;
+            }
+        } else {
+            return false;
+        }
+        p = end;
+
+        rule.time = DEFAULT_TIME_S;
+        if (*p == '/') {
+            p++;
+            return ParseOffset(p, rule.time);
+        }
+        return true;
+    }
+
+    int32_t m_stdOffset{0};  // seconds east of UTC
+    int32_t m_dstOffset{0};
+    bool m_hasDst{false};
+    Rule m_start{}, m_end{};
+
+    int32_t m_offset{0};
+    int64_t m_validFrom{INT64_MAX};  // nothing is cached yet
+    int64_t m_validUntil{INT64_MIN};
+};
@@ -0,0 +1,108 @@
+#pragma once
+#include <stdint.h>
+#include <vector>
+
+#include <civil_time.hpp>
+#include <display_defaults.hpp>
+
+// How hard the clock works during part of the day, e.g. at night in a
+// bedroom it can draw fewer frames at a lower brightness.
+struct PowerProfile {
+    uint8_t fps{FRAMES_PER_SECOND};  // the clock's, menus run at full speed
+    uint8_t maxBrightness{MAX_DISPLAY_BRIGHTNESS};  // the ceiling
+    uint8_t animation{0};  // an ANIM number, 0 = whatever ANIM is set to
+    bool wifiPowerSave{false};
+    uint16_t cpuMhz{CPU_MHZ_DEFAULT};  // ignored while Pixels::IS_CPU_TIMED
+
+    bool operator==(const PowerProfile& other) const {
+        return fps == other.fps && maxBrightness == other.maxBrightness &&
+               animation == other.animation &&
+               wifiPowerSave == other.wifiPowerSave && cpuMhz == other.cpuMhz;
+    }
+    bool operator!=(const PowerProfile& other) const {
+        return !(*this == other);
+    }
+};
+
+// Profiles that each start at a time of day and last until the next one
+// starts, wrapping around midnight. When the active one is worked out, so
+// is when it ends, so Update() is only a compare until then.
+class ProfileSchedule {
+  public:
+    enum : int32_t {
+        MINUTES_PER_DAY = 24 * 60,
+    };
+
+    void Clear() {
+        m_entries.clear();
+        Invalidate();
+    }
+
+    void Add(const uint16_t startMinute, const PowerProfile& profile) {
+        auto it = m_entries.begin();
+        while (it != m_entries.end() && it->startMinute < startMinute) {
+            ++it;
+        }
+        m_entries.insert(it, {(uint16_t)(startMinute % MINUTES_PER_DAY),
+                              profile});
+        Invalidate();
+    }
+
+    // |localEpoch| is local seconds since 1970. Returns true when it's
+    // moved into another profile, see Active().
+    bool Update(const int64_t localEpoch) {
+        if (m_entries.empty() ||
+            (localEpoch >= m_activeFrom && localEpoch < m_activeUntil)) {
+            return false;
+        }
+
+        const int64_t dayStart =
+            CivilTime::DaysFromEpoch(localEpoch) * CivilTime::DAY_S;
+        const int32_t minute = (localEpoch - dayStart) / 60;
+
+        // the last one to start today, or if none has yet, yesterday's last
+        size_t active = m_entries.size() - 1;
+        int64_t from = dayStart - CivilTime::DAY_S;
+        for (size_t i = 0; i < m_entries.size(); ++i) {
+            if (m_entries[i].startMinute <= minute) {
+                active = i;
+                from = dayStart;
+            }
+        }
+        m_activeFrom = from + m_entries[active].startMinute * 60;
+
+        const size_t next = (active + 1) % m_entries.size();
+        m_activeUntil = dayStart + m_entries[next].startMinute * 60;
+        if (m_activeUntil <= localEpoch) {
+            m_activeUntil += CivilTime::DAY_S;
+        }
+
+        const bool changed = m_active != (int)active;
+        m_active = active;
+        return changed;
+    }
+
+    // nullptr until there's a profile and Update() has been called
+    const PowerProfile* Active() const {
+        return m_active < 0 ? nullptr : &m_entries[m_active].profile;
+    }
+
+    int64_t GetNextSwitch() const { return m_activeUntil; }
+
+  private:
+    void Invalidate() {
+        m_active = -1;
+        m_activeFrom = INT64_MAX;
+        m_activeUntil = INT64_MIN;
+    }
+
+    struct Entry {
+        uint16_t startMinute;
+        PowerProfile profile;
+    };
+    std::vector<Entry> m_entries;
+
+    int m_active{-1};
+    int64_t m_activeFrom{INT64_MAX};
+    int64_t m_activeUntil{INT64_MIN};
+};
@@ -1,23 +1,32 @@
 #pragma once
 #include <Rtc_Pcf8563.h>
-#include <Time.h>
-#include <Timezone.h>  // https://github.com/JChristensen/Timezone
 #if FCOS_ESP32_C3
 #include <WiFi.h>
 #elif FCOS_ESP8266
 #include <ESP8266WiFi.h>
 #endif
+#include <sys/time.h>
+#include <atomic>
 #include <map>
 #include <vector>
 
+#include <clock_discipline.hpp>
 #include <elapsed_time.hpp>
+#include <event_flags.hpp>
+#include <pcf8563_time.hpp>
+#include <posix_tz.hpp>
 #include <settings.hpp>
+#include <time_base.hpp>
+#include <timezones.hpp>
 
 class Rtc {
   private:
     enum {
         TIMER_FREQUENCY = 1,  // at 1Hz, this results in 1 interrupt per second
-        MAX_WAIT_FOR_NTP_MS = 250,
+        I2C_ADDRESS = 0x51,
+        // between reads, the time is counted from the interrupt instead
+        RESYNC_INTERVAL_S = 10 * 60,
+        EDGE_RING_SIZE = 8,  // the edges kept for a loop that stalled
     };
 
     std::shared_ptr<Settings> m_settings;
@@ -25,46 +34,100 @@ class Rtc {
     Rtc_Pcf8563 m_rtc;
     bool m_isInitialized{false};
 
-    uint8_t m_hour{0}, m_minute{0}, m_second{0};  // 12:00:00 AM
-    size_t m_millisAtInterrupt{0};
+    Pcf8563Time m_time;  // 12:00:00 AM
+    size_t m_secondsUntilResync{0};
+    size_t m_millisAtInterrupt{0};  // until the 1Hz interrupt is running
     size_t m_uptime{0};
+    TimeBase m_timeBase;  // sub-second time, locked to the 1Hz interrupt
 
-    struct tm m_timeinfo;
-    size_t m_uptimeForNextNTPUpdate{5};
+    // NTP arrives from the SDK's own task whenever it syncs, and is applied
+    // just after the next RTC edge
+    static std::atomic<bool> m_receivedNTP;
+    static struct timeval m_ntpTime;
+    static uint32_t m_ntpMicros;  // micros() when m_ntpTime was current
+    ClockDiscipline m_discipline;  // RTC drift, measured between syncs
+    size_t m_uptimeAtNTP{0};
 
-    static bool m_receivedInterrupt;  // used by InterruptISR()
+    // written only by InterruptISR(); Update() drains every tick since the
+    // last time it ran, even if the loop stalled for several seconds
+    static std::atomic<uint32_t> m_ticks;
+    static volatile uint32_t m_edgeMicros[EDGE_RING_SIZE];
+    uint32_t m_drainedTicks{0};
+    uint32_t m_lastEdgeMicros{0};
 
   public:
+    // the I2C traffic to the RTC, which shares the bus with other sensors
+    struct I2cStats {
+        uint32_t reads{0};
+        uint32_t failures{0};  // bus errors or registers that didn't validate
+        uint64_t totalUs{0};
+        uint32_t maxUs{0};
+    };
+
+    // how often the loop was too slow to see each interrupt on its own
+    struct TickStats {
+        uint32_t coalesced{0};  // ticks drained along with another one
+        uint32_t maxPending{0};  // the most drained at once, i.e. the stall
+        uint32_t missed{0};  // interrupts that never arrived
+    };
+
     Rtc(std::shared_ptr<Settings> settings);
 
     bool IsInitialized();
     void Update();
 
-    uint8_t Hour() { return m_hour; }
+    uint8_t Hour() { return m_time.hour; }
     uint8_t Hour12() { return Conv24to12(Hour()); }
-    uint8_t Minute() { return m_minute; }
-    uint8_t Second() { return m_second; }
-    size_t Millis() { return ((size_t)millis() - m_millisAtInterrupt) % 1000; }
+    uint8_t Minute() { return m_time.minute; }
+    uint8_t Second() { return m_time.second; }
+    uint16_t Year() { return m_time.year; }
+    uint8_t Month() { return m_time.month; }  // 1-12
+    uint8_t Day() { return m_time.day; }      // 1-31
+    uint8_t Weekday() { return m_time.weekday; }  // 0 = Sunday
+    // seconds since 1970, in local time as the clock shows it, and in UTC
+    int64_t LocalEpoch() { return m_time.Epoch(); }
+    int64_t Epoch();
+    size_t Millis();
+    // at the RTC's rate rather than the CPU's. Only goes forwards, except
+    // for one step back when an error over 100ms is stepped out (e.g. after
+    // the RTC is set), see TimeBase
+    uint64_t Micros() { return m_timeBase.Micros(micros()); }
+    const TimeBase& GetTimeBase() const { return m_timeBase; }
+    // 0 when it's due, or until the interrupt has been running for a while
+    uint32_t MicrosUntilNextTick() {
+        return m_timeBase.MicrosUntilNextEdge(micros());
+    }
+    // whether the interrupt has fired since Update() last drained the ticks
+    bool IsTickPending() const {
+        return m_ticks.load(std::memory_order_acquire) != m_drainedTicks;
+    }
     size_t Uptime() { return m_uptime; }
+    const I2cStats& GetI2cStats() const { return m_i2cStats; }
+    const TickStats& GetTickStats() const { return m_tickStats; }
+    const ClockDiscipline& GetClockDiscipline() const { return m_discipline; }
 
     void SetTime(uint8_t hour, uint8_t minute, uint8_t second);
+    void SetDateTime(int64_t localEpoch);
     static int Conv24to12(int hour);
     void SetClockToZero();
-    std::vector<String> GetTimezoneNames();
-    int GetTimezoneNumFromName(const String& name);
+    // an index into Timezones, also saved in the settings
+    void SetTimezone(int index);
+    int GetTimezone() { return (*m_settings)["TIMEZONE"].as<int>(); }
     void ForceNTPUpdate();
 
   private:
     void Initialize();
-    void GetTimeFromRTC();
+    bool GetTimeFromRTC();
+    bool ReadTimeRegisters(Pcf8563Time& time);
+    I2cStats m_i2cStats;
+    uint32_t DrainTicks();
+    TickStats m_tickStats;
     void CheckNTPTime();
-    bool GetLocalTime(struct tm* info, uint32_t ms);
+    void CorrectDrift(uint32_t seconds);
+    void CheckDaylightSaving();
+    static void OnNTPSync(struct timeval* tv);
 
-    struct NamedTimezone {
-        String name;
-        Timezone tz;
-    };
-    std::vector<NamedTimezone> m_timezones;
+    PosixTz m_timezone;
     void SetupTimezones();
 
     void AttachInterrupt();
@@ -0,0 +1,114 @@
+#pragma once
+#include <stdint.h>
+#include <array>
+
+#include <pixels.hpp>
+
+// std::sin() isn't constexpr, so the table uses Bhaskara I's
+// approximation instead, which stays within one step of the real thing
+static constexpr std::array<uint8_t, 256> BuildSin8Table() {
+    constexpr double pi = 3.14159265358979;
+    std::array<uint8_t, 256> table{};
+    for (int i = 0; i < 256; ++i) {
+        const double x = (i % 128) * pi / 128;
+        const double s =
+            16 * x * (pi - x) / (5 * pi * pi - 4 * x * (pi - x));
+        const double v = i < 128 ? 128 + s * 127 : 128 - s * 127;
+        table[i] = (uint8_t)(v + 0.5);
+    }
+    return table;
+}
+
+// Integer helpers for per-pixel shaders. Angles, hues and intensities are
+// all 0-255, so a full turn wraps naturally in a uint8_t and nothing in a
+// shader needs floating point.
+class ShaderMath {
+  public:
+    // 128 +/- 127 * sin(theta * 2pi / 256)
+    static uint8_t Sin8(const uint8_t theta) { return SIN_TABLE[theta]; }
+
+    // v * s / 255, e.g. to dim a channel by an intensity
+    static uint8_t Scale8(const uint8_t v, const uint8_t s) {
+        return (v * (s + 1)) >> 8;
+    }
+
+    static uint8_t Lerp8(const uint8_t a, const uint8_t b, const uint8_t f) {
+        return a + (((b - a) * f) >> 8);
+    }
+
+    // 2D value noise. x and y are 8.8 fixed point, so one lattice cell is
+    // 256 units wide and neighbouring LEDs can be any distance apart.
+    static uint8_t Noise8(const uint16_t x, const uint16_t y) {
+        const uint8_t xi = x >> 8, yi = y >> 8;
+        const uint8_t u = Ease8(x & 0xFF), v = Ease8(y & 0xFF);
+        return Lerp8(Lerp8(Hash8(xi, yi), Hash8(xi + 1, yi), u),
+                     Lerp8(Hash8(xi, yi + 1), Hash8(xi + 1, yi + 1), u), v);
+    }
+
+    // a color from the active palette, see Pixels::ColorWheel()
+    static RgbColor Hue(const uint8_t pos) { return Pixels::ColorWheel(pos); }
+
+    static RgbColor Dim(const RgbColor& color, const uint8_t level) {
+        return RgbColor(Scale8(color.R, level), Scale8(color.G, level),
+                        Scale8(color.B, level));
+    }
+
+  private:
+    // smoothstep, 3f^2 - 2f^3
+    static uint8_t Ease8(const uint8_t f) {
+        return ((uint32_t)f * f * (3 * 256 - 2 * f)) >> 16;
+    }
+
+    static uint8_t Hash8(const uint8_t x, const uint8_t y) {
+        uint32_t h = x * 374761393u + y * 668265263u;
+        h = (h ^ (h >> 13)) * 1274126177u;
+        return h >> 24;
+    }
+
+    static constexpr std::array<uint8_t, 256> SIN_TABLE = BuildSin8Table();
+};
+
+// What an animator hands to its shader each frame, besides x, y and t
+struct ShaderParams {
+    uint8_t hue{0};     // the selected color (COLR)
+    uint8_t level{48};  // background intensity, kept low so digits stand out
+};
+
+// A shader is any type with
+//     RgbColor operator()(int x, int y, uint32_t t, const ShaderParams& p)
+// which Pixels::Shade() evaluates for every matrix LED. t is in ms.
+
+struct PlasmaShader {
+    RgbColor operator()(const int x,
+                        const int y,
+                        const uint32_t t,
+                        const ShaderParams& p) const {
+        using M = ShaderMath;
+        const uint8_t t1 = t >> 4, t2 = t >> 5;
+        const uint16_t sum = M::Sin8(x * 19 + t1) + M::Sin8(y * 23 - t2) +
+                             M::Sin8((x + y) * 11 + t2) +
+                             M::Sin8(M::Sin8(x * 8 + t1) / 2 + y * 16);
+        return M::Dim(M::Hue(p.hue + (sum >> 2)), p.level);
+    }
+};
+
+struct GradientShader {
+    RgbColor operator()(const int x,
+                        const int y,
+                        const uint32_t t,
+                        const ShaderParams& p) const {
+        using M = ShaderMath;
+        return M::Dim(M::Hue(p.hue + x * 5 + y * 3 - (t >> 6)), p.level);
+    }
+};
+
+struct NoiseShader {
+    RgbColor operator()(const int x,
+                        const int y,
+                        const uint32_t t,
+                        const ShaderParams& p) const {
+        using M = ShaderMath;
+        const uint8_t n = M::Noise8(x * 72 + (t >> 3), y * 72 + (t >> 4));
+        return M::Dim(M::Hue(p.hue + (n >> 2)), M::Scale8(p.level, n));
+    }
+};
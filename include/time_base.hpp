@@ -0,0 +1,126 @@
+#pragma once
+#include <stdint.h>
+#include <stdlib.h>  // for abs()
+
+// A software phase-locked loop that turns the RTC's 1Hz interrupt, as
+// timestamped with micros() in the ISR, into a sub-second clock. Between
+// edges it extrapolates with micros(), scaled by how fast micros() has
+// been running compared to the RTC. At each edge, a small phase error is
+// slewed out over the next second instead of jumping, so the time doesn't
+// go backwards for jitter and doesn't depend on how late the main loop
+// noticed the interrupt. Errors too big to slew out in a few seconds (the
+// first edges, missed ones, or the RTC being set) are stepped instead, in
+// either direction.
+class TimeBase {
+  public:
+    enum : uint32_t {
+        SECOND_US = 1000000,
+        // further ahead or behind than this and it jumps instead of slewing
+        STEP_THRESHOLD_US = 100000,
+        // a period further than this from a second (2%) is a glitch or a
+        // step of the RTC, which says nothing about the frequency
+        MAX_PERIOD_ERROR_US = SECOND_US / 50,
+        // the most a second is stretched or shortened by to fix the phase
+        MAX_SLEW_US = 5000,
+        FREQUENCY_SMOOTHING = 8,  // each period counts for 1/8 of the estimate
+        LOCKED_US = 1000,
+        LOCK_EDGES = 4,
+    };
+
+    // |edgeUs| is micros() when an RTC second began
+    void OnEdge(const uint32_t edgeUs) {
+        if (m_edges == 0) {
+            m_anchorLocalUs = m_lastEdgeUs = edgeUs;
+            m_anchorUs = 0;
+            m_edges = 1;
+            return;
+        }
+
+        // a gap of several periods means edges were missed, which still
+        // count as seconds but say nothing about the frequency
+        const uint32_t measured = edgeUs - m_lastEdgeUs;
+        const uint32_t seconds =
+            measured < m_periodUs * 1.5f ? 1 : (uint32_t)(measured / m_periodUs + 0.5f);
+        const int32_t periodErrorUs = (int32_t)(measured - SECOND_US);
+        if (seconds == 1 &&
+            abs(periodErrorUs) <= (int32_t)MAX_PERIOD_ERROR_US) {
+            m_periodUs += (measured - m_periodUs) / FREQUENCY_SMOOTHING;
+        }
+        m_edges += seconds;
+        m_lastEdgeUs = edgeUs;
+
+        uint64_t now = Micros(edgeUs);
+        const uint64_t expected = SecondStartUs();
+        m_phaseErrorUs = (int64_t)(expected - now);
+        if (abs(m_phaseErrorUs) > (int32_t)STEP_THRESHOLD_US) {
+            // slewing this out at MAX_SLEW_US a second would take minutes
+            now = expected;
+            m_phaseErrorUs = 0;
+        }
+
+        int32_t correction = m_phaseErrorUs / 2;
+        if (correction > (int32_t)MAX_SLEW_US) {
+            correction = MAX_SLEW_US;
+        } else if (correction < -(int32_t)MAX_SLEW_US) {
+            correction = -(int32_t)MAX_SLEW_US;
+        }
+        m_rate = (SECOND_US + correction) / m_periodUs;
+        m_anchorUs = now;
+        m_anchorLocalUs = edgeUs;
+    }
+
+    // monotonic microseconds since the first edge, at the RTC's rate
+    uint64_t Micros(const uint32_t nowUs) const {
+        return m_anchorUs + (uint64_t)((nowUs - m_anchorLocalUs) * m_rate);
+    }
+
+    // how far into the second that began at the last OnEdge(), 0-999999.
+    // It holds at the end of a second until the next edge is processed, so
+    // it can't wrap around while Second() still shows the previous one.
+    uint32_t MicrosIntoSecond(const uint32_t nowUs) const {
+        if (m_edges == 0) {
+            return 0;
+        }
+        const uint64_t now = Micros(nowUs);
+        const uint64_t start = SecondStartUs();
+        if (now <= start) {
+            return 0;
+        }
+        return now - start >= SECOND_US ? SECOND_US - 1 : now - start;
+    }
+
+    // when the next edge is due, in micros() from |nowUs|, or 0 if it's due
+    // already or there haven't been enough edges to know
+    uint32_t MicrosUntilNextEdge(const uint32_t nowUs) const {
+        if (m_edges < 2) {
+            return 0;
+        }
+        const int32_t untilUs =
+            (int32_t)(m_lastEdgeUs + (uint32_t)m_periodUs - nowUs);
+        return untilUs > 0 ? untilUs : 0;
+    }
+
+    // how much faster micros() runs than the RTC, in parts per million
+    float GetFrequencyErrorPpm() const { return m_periodUs - SECOND_US; }
+
+    int32_t GetPhaseErrorUs() const { return m_phaseErrorUs; }
+
+    uint32_t GetEdges() const { return m_edges; }
+
+    bool IsLocked() const {
+        return m_edges >= LOCK_EDGES && abs(m_phaseErrorUs) < (int32_t)LOCKED_US;
+    }
+
+  private:
+    uint64_t SecondStartUs() const {
+        return (uint64_t)(m_edges - 1) * SECOND_US;
+    }
+
+    float m_periodUs{SECOND_US};  // micros() per RTC second
+    float m_rate{1.0f};           // RTC us per micros(), with the correction
+    uint32_t m_anchorLocalUs{0};
+    uint64_t m_anchorUs{0};  // Micros() at m_anchorLocalUs
+    uint32_t m_lastEdgeUs{0};
+    uint32_t m_edges{0};
+    int32_t m_phaseErrorUs{0};
+};
@@ -0,0 +1,269 @@
+#pragma once
+#include <stdint.h>
+#include <functional>
+#include <vector>
+
+// One-shot and periodic callbacks, kept in a hierarchical timing wheel so
+// that Update() costs the same however many timers there are. Level 0 has a
+// slot per ms for the next 64ms, level 1 a slot per 64ms for the next ~4s,
+// and so on up to ~4.6 hours; timers further out wait in the last level. A
+// bitmap per level says which slots have timers in them, so Update() jumps
+// straight to the next slot that does, and timers only move down a level
+// (cascade) when their slot comes around.
+class TimerWheel {
+  public:
+    using Callback = std::function<void()>;
+    using Id = int;
+
+    enum : int {
+        INVALID = -1,
+        SLOT_BITS = 6,
+        SLOTS = 1 << SLOT_BITS,
+        LEVELS = 4,
+    };
+    enum : uint32_t {
+        NONE = 0xFFFFFFFF,  // from MsUntilNext(), when nothing is running
+    };
+
+    TimerWheel() {
+        for (Id& head : m_heads) {
+            head = INVALID;
+        }
+    }
+
+    // a stopped timer, which belongs to the caller until Remove()
+    Id Add(Callback callback) {
+        Id id;
+        if (m_free != INVALID) {
+            id = m_free;
+            m_free = m_timers[id].next;
+        } else {
+            id = m_timers.size();
+            m_timers.emplace_back();
+        }
+        m_timers[id] = Timer();
+        m_timers[id].callback = std::move(callback);
+        return id;
+    }
+
+    void Remove(const Id id) {
+        Stop(id);
+        m_timers[id].callback = nullptr;
+        m_timers[id].next = m_free;
+        m_free = id;
+    }
+
+    // fires once |ms| from now, or that much later if it was running
+    void Start(const Id id, const uint32_t ms) { Schedule(id, ms, 0); }
+
+    // fires every |periodMs|, starting |periodMs| from now
+    void StartPeriodic(const Id id, const uint32_t periodMs) {
+        Schedule(id, periodMs, periodMs);
+    }
+
+    void Stop(const Id id) {
+        if (m_timers[id].slot != STOPPED) {
+            Unlink(id);
+        }
+    }
+
+    bool IsRunning(const Id id) const {
+        return m_timers[id].slot != STOPPED;
+    }
+
+    Id Every(const uint32_t periodMs, Callback callback) {
+        const Id id = Add(std::move(callback));
+        StartPeriodic(id, periodMs);
+        return id;
+    }
+
+    // fires whatever is due by |nowMs|, e.g. millis(), which may wrap
+    void Update(const uint32_t nowMs) {
+        if (!m_hasUpdated) {
+            m_lastMs = nowMs;
+            m_hasUpdated = true;
+        }
+        m_target = m_now + (uint32_t)(nowMs - m_lastMs);
+        m_lastMs = nowMs;
+
+        for (;;) {
+            const uint64_t next = NextEventTick();
+            if (next > m_target) {
+                break;
+            }
+            m_now = next;
+            for (int level = LEVELS - 1; level > 0; --level) {
+                if ((m_now & ((1ull << (level * SLOT_BITS)) - 1)) == 0) {
+                    Cascade(level);
+                }
+            }
+            Fire();
+        }
+        m_now = m_target;
+    }
+
+    // how long until the next timer could be due, at least. A timer that's
+    // still in a higher level gives when it cascades, which is earlier
+    // than (or exactly) when it fires.
+    uint32_t MsUntilNext() const {
+        const uint64_t next = NextEventTick();
+        if (next == NEVER) {
+            return NONE;
+        }
+        return next - m_now > NONE - 1 ? NONE - 1 : next - m_now;
+    }
+
+  private:
+    enum : int {
+        STOPPED = -1,
+        FIRING = -2,  // taken out of its slot, and about to fire
+    };
+    static constexpr uint64_t NEVER = ~0ull;
+
+    struct Timer {
+        Callback callback;
+        uint64_t expires{0};
+        uint32_t periodMs{0};
+        int slot{STOPPED};  // level * SLOTS + index, or STOPPED/FIRING
+        Id prev{INVALID};
+        Id next{INVALID};  // also the free list
+    };
+
+    void Schedule(const Id id, const uint32_t ms, const uint32_t periodMs) {
+        Stop(id);
+        m_timers[id].periodMs = periodMs;
+        m_timers[id].expires = m_now + (ms > 0 ? ms : 1);
+        Insert(id);
+    }
+
+    void Insert(const Id id) {
+        Timer& timer = m_timers[id];
+        if (timer.expires < m_now) {
+            timer.expires = m_now;
+        }
+        // due now (from a cascade) goes in the level 0 slot about to fire
+        const uint64_t delta = timer.expires - m_now;
+        int level = 0;
+        while (level < LEVELS - 1 &&
+               delta >= (1ull << ((level + 1) * SLOT_BITS))) {
+            ++level;
+        }
+        // too far out for the wheel waits at the end of it, and is put
+        // back each time its slot comes around until it's close enough
+        const uint64_t maxDelta = (1ull << (LEVELS * SLOT_BITS)) - 1;
+        const uint64_t at = delta > maxDelta ? m_now + maxDelta : timer.expires;
+        const int index = (at >> (level * SLOT_BITS)) & (SLOTS - 1);
+        Link(id, level * SLOTS + index);
+    }
+
+    void Link(const Id id, const int slot) {
+        Timer& timer = m_timers[id];
+        Id& head = slot == FIRING ? m_firing : m_heads[slot];
+        timer.slot = slot;
+        timer.prev = INVALID;
+        timer.next = head;
+        if (head != INVALID) {
+            m_timers[head].prev = id;
+        }
+        head = id;
+        if (slot >= 0) {
+            m_occupied[slot / SLOTS] |= 1ull << (slot % SLOTS);
+        }
+    }
+
+    void Unlink(const Id id) {
+        Timer& timer = m_timers[id];
+        const int slot = timer.slot;
+        Id& head = slot == FIRING ? m_firing : m_heads[slot];
+        if (timer.prev != INVALID) {
+            m_timers[timer.prev].next = timer.next;
+        } else {
+            head = timer.next;
+        }
+        if (timer.next != INVALID) {
+            m_timers[timer.next].prev = timer.prev;
+        }
+        if (slot >= 0 && head == INVALID) {
+            m_occupied[slot / SLOTS] &= ~(1ull << (slot % SLOTS));
+        }
+        timer.slot = STOPPED;
+        timer.prev = timer.next = INVALID;
+    }
+
+    // moves a slot's timers out, and calls |func| with each of them
+    template <typename Func>
+    void TakeSlot(const int slot, Func func) {
+        while (m_heads[slot] != INVALID) {
+            const Id id = m_heads[slot];
+            Unlink(id);
+            func(id);
+        }
+    }
+
+    void Cascade(const int level) {
+        const int index = (m_now >> (level * SLOT_BITS)) & (SLOTS - 1);
+        TakeSlot(level * SLOTS + index, [&](const Id id) { Insert(id); });
+    }
+
+    void Fire() {
+        // callbacks can start and stop timers, including ones that are due
+        // now, so the due ones are moved to their own list first
+        TakeSlot(m_now & (SLOTS - 1), [&](const Id id) { Link(id, FIRING); });
+        while (m_firing != INVALID) {
+            const Id id = m_firing;
+            Unlink(id);
+            Timer& timer = m_timers[id];
+            if (timer.periodMs > 0) {
+                // periods that a stall skipped aren't caught up on
+                timer.expires += timer.periodMs;
+                if (timer.expires <= m_target) {
+                    timer.expires += ((m_target - timer.expires) /
+                                          timer.periodMs +
+                                      1) *
+                                     timer.periodMs;
+                }
+                Insert(id);
+            }
+            // a copy, as the callback may Remove() its own timer
+            Callback callback = m_timers[id].callback;
+            if (callback) {
+                callback();
+            }
+        }
+    }
+
+    // when the next slot with anything in it comes around: for level 0
+    // that's when its timers fire, for higher levels when they cascade
+    uint64_t NextEventTick() const {
+        uint64_t next = NEVER;
+        for (int level = 0; level < LEVELS; ++level) {
+            const uint64_t bits = m_occupied[level];
+            if (bits == 0) {
+                continue;
+            }
+            const int shift = level * SLOT_BITS;
+            const int current = (m_now >> shift) & (SLOTS - 1);
+            // the first occupied slot after the current one, wrapping around
+            const int from = (current + 1) & (SLOTS - 1);
+            const uint64_t rotated =
+                (bits >> from) | (from ? bits << (SLOTS - from) : 0);
+            const int distance = __builtin_ctzll(rotated) + 1;
+            const uint64_t tick = ((m_now >> shift) + distance) << shift;
+            if (tick < next) {
+                next = tick;
+            }
+        }
+        return next;
+    }
+
+    std::vector<Timer> m_timers;
+    Id m_free{INVALID};
+    Id m_heads[LEVELS * SLOTS];
+    uint64_t m_occupied[LEVELS]{};
+    Id m_firing{INVALID};
+
+    uint64_t m_now{0};  // ms since the first Update()
+    uint64_t m_target{0};  // what Update() is catching up to
+    uint32_t m_lastMs{0};
+    bool m_hasUpdated{false};
+};
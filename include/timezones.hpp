@@ -0,0 +1,31 @@
+#pragma once
+#include <Arduino.h>
+
+// Every IANA timezone, as a POSIX TZ string for PosixTz. The tables are
+// generated by gen_timezones.py into src/timezone_data.cpp and stay in
+// flash (PROGMEM), so they're only read through the _P functions. Zones are
+// numbered in alphabetical order of their names.
+class Timezones {
+  public:
+    enum {
+        MAX_NAME_LENGTH = 63,
+        MAX_RULE_LENGTH = 63,
+    };
+
+    static int Count() { return COUNT; }
+    static String Name(int index);
+    static int Find(const String& name);  // -1 if there's no such zone
+    static String Rule(int index);
+
+    // the names, separated by spaces, where a name starting with "/" is in
+    // the same region as the one before it, e.g. "Europe/Paris /Prague".
+    // It's in PROGMEM, e.g. for WebServer::sendContent_P(), and the WiFi
+    // setup page unpacks it itself.
+    static PGM_P PackedNames() { return NAMES; }
+
+  private:
+    static const int COUNT;
+    static const char NAMES[] PROGMEM;
+    static const char RULES[] PROGMEM;  // each one ends with a '\0'
+    static const uint8_t ZONE_RULES[] PROGMEM;
+};
@@ -0,0 +1,93 @@
+#pragma once
+#include <stdint.h>
+#include <algorithm>  // for std::fill, std::max
+#include <cmath>      // for exp2f, floorf
+#include <vector>
+
+// The channels behind Pixels::Layer: R, G and B for each LED of a W x H
+// matrix, kept unscaled in 8.8 fixed point so slow fades don't stall at low
+// levels. It's apart from NeoPixelBus so that it can be tested on the host.
+template <int W, int H>
+class TrailBuffer {
+  public:
+    enum : int {
+        WIDTH = W,
+        HEIGHT = H,
+        LEDS = W * H,
+    };
+
+    TrailBuffer() : m_channels(LEDS * 3, 0) {}
+
+    void Clear() { std::fill(m_channels.begin(), m_channels.end(), 0); }
+
+    void Set(const int x,
+             const int y,
+             const uint8_t r,
+             const uint8_t g,
+             const uint8_t b) {
+        if (x >= 0 && x < W && y >= 0 && y < H) {
+            uint16_t* channel = &m_channels[(y * W + x) * 3];
+            channel[0] = r << 8;
+            channel[1] = g << 8;
+            channel[2] = b << 8;
+        }
+    }
+
+    // a particle at a fractional position, spread bilinearly over the 2x2
+    // LEDs around it. As with truncating to int, LED x covers x to x + 1, so
+    // a particle at 4.5 lands entirely on LED 4. Each LED keeps the brighter
+    // of its trail and the particle's share, so a particle that stays put
+    // is never brighter than its own color however often it's splatted.
+    void Splat(const float x,
+               const float y,
+               const uint8_t r,
+               const uint8_t g,
+               const uint8_t b) {
+        // 8.8 fixed point, moved by half an LED so that LED centers are whole
+        const int fx = (int)floorf(x * 256) - 128;
+        const int fy = (int)floorf(y * 256) - 128;
+        const int ix = fx >> 8, iy = fy >> 8;
+        const uint32_t wx = fx & 0xFF, wy = fy & 0xFF;
+        const uint8_t values[3] = {r, g, b};
+
+        Blend(ix, iy, values, (256 - wx) * (256 - wy));
+        Blend(ix + 1, iy, values, wx * (256 - wy));
+        Blend(ix, iy + 1, values, (256 - wx) * wy);
+        Blend(ix + 1, iy + 1, values, wx * wy);
+    }
+
+    // channel 0-2 (R, G, B) of the LED at |pos|, row by row
+    uint8_t Get(const int pos, const int channel) const {
+        return m_channels[pos * 3 + channel] >> 8;
+    }
+
+    // what's left of a trail after |elapsedMs|, in 16.16 fixed point
+    static uint32_t Keep(const float elapsedMs, const uint16_t halfLifeMs) {
+        return 65536 * exp2f(-elapsedMs / std::max<uint16_t>(1, halfLifeMs));
+    }
+
+    void Fade(const int pos, const uint32_t keep) {
+        uint16_t* channel = &m_channels[pos * 3];
+        channel[0] = (channel[0] * keep) >> 16;
+        channel[1] = (channel[1] * keep) >> 16;
+        channel[2] = (channel[2] * keep) >> 16;
+    }
+
+  private:
+    // weight is 0-65536
+    void Blend(const int x,
+               const int y,
+               const uint8_t values[3],
+               const uint32_t weight) {
+        if (weight == 0 || x < 0 || x >= W || y < 0 || y >= H) {
+            return;
+        }
+        uint16_t* channel = &m_channels[(y * W + x) * 3];
+        for (int i = 0; i < 3; ++i) {
+            channel[i] =
+                std::max<uint32_t>(channel[i], (values[i] * weight) >> 8);
+        }
+    }
+
+    std::vector<uint16_t> m_channels;
+};
@@ -0,0 +1,67 @@
+#pragma once
+#include <algorithm>  // for std::min/max
+#include <cmath>      // for logf, powf
+
+// The color of white, as R, G and B multipliers (0-1) for a color
+// temperature, relative to 6500K so that daylight leaves colors alone.
+struct WhitePoint {
+    float r{1.0f};
+    float g{1.0f};
+    float b{1.0f};
+
+    enum {
+        DAYLIGHT_K = 6500,
+        MIN_K = 1900,
+    };
+
+    // Tanner Helland's fit of the black body curve, good to a few percent
+    // between 1000K and 40000K
+    static WhitePoint FromKelvin(const float kelvin) {
+        const WhitePoint k = BlackBody(kelvin);
+        const WhitePoint day = BlackBody(DAYLIGHT_K);
+        return {std::min(k.r / day.r, 1.0f), std::min(k.g / day.g, 1.0f),
+                std::min(k.b / day.b, 1.0f)};
+    }
+
+    // How far toward the night white point to go (0-1), given the time of
+    // day and how bright the room is (0-1). Evenings warm up over two hours
+    // from 19:00 and mornings cool down over two hours from 6:00, and a
+    // bright room at night only gets half of the shift.
+    static float CircadianWarmth(const int minuteOfDay, const float ambient) {
+        enum {
+            EVENING = 19 * 60,
+            MORNING = 6 * 60,
+            RAMP = 2 * 60,
+        };
+        float night;
+        if (minuteOfDay >= EVENING) {
+            night = std::min((minuteOfDay - EVENING) / (float)RAMP, 1.0f);
+        } else if (minuteOfDay < MORNING) {
+            night = 1.0f;
+        } else {
+            night = std::max(1.0f - (minuteOfDay - MORNING) / (float)RAMP,
+                             0.0f);
+        }
+        const float darkness = 1.0f - std::min(ambient * 4.0f, 1.0f);
+        return night * (0.5f + 0.5f * darkness);
+    }
+
+  private:
+    static WhitePoint BlackBody(const float kelvin) {
+        const float t = std::max(kelvin, 1000.0f) / 100.0f;
+        WhitePoint c;
+        if (t <= 66) {
+            c.r = 255;
+            c.g = 99.4708025861f * logf(t) - 161.1195681661f;
+            c.b = t <= 19 ? 0 : 138.5177312231f * logf(t - 10) - 305.0447927307f;
+        } else {
+            c.r = 329.698727446f * powf(t - 60, -0.1332047592f);
+            c.g = 288.1221695283f * powf(t - 60, -0.0755148492f);
+            c.b = 255;
+        }
+        c.r = std::min(std::max(c.r, 1.0f), 255.0f);
+        c.g = std::min(std::max(c.g, 1.0f), 255.0f);
+        c.b = std::min(std::max(c.b, 1.0f), 255.0f);
+        return c;
+    }
+};
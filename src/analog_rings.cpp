@@ -0,0 +1,147 @@
+#include <analog_rings.hpp>
+
+#if FCOS_CARDCLOCK || FCOS_CARDCLOCK2
+#include <array>
+
+// Brightness of the LED that a hand is moving towards, by how far (0-255) it
+// has moved. The LED it is leaving uses [255 - progress]. This eases out
+// instead of being linear, so a hand halfway between two LEDs doesn't look
+// dimmer than one sitting on an LED.
+static constexpr std::array<uint8_t, 256> BuildCrossfadeTable() {
+    std::array<uint8_t, 256> table{};
+    for (int i = 0; i < 256; ++i) {
+        table[i] = 255 - ((255 - i) * (255 - i)) / 255;
+    }
+    return table;
+}
+
+// Brightness of each ring for the second hand over the course of a second.
+// The brightest point travels from ring 0 to the last ring, which is what
+// DrawSecondLEDs approximated with three fixed steps.
+template <typename Geometry>
+struct SubsecondTable {
+    enum { STEPS = BasicAnalogRings<Geometry>::SUBSECOND_STEPS };
+    uint8_t weights[STEPS][Geometry::NUM_RINGS];
+};
+
+template <typename Geometry>
+static constexpr SubsecondTable<Geometry> BuildSubsecondTable() {
+    enum {
+        STEPS = SubsecondTable<Geometry>::STEPS,
+        RINGS = Geometry::NUM_RINGS,
+    };
+    SubsecondTable<Geometry> table{};
+    const int span = (RINGS > 1 ? RINGS - 1 : 1) * 256;
+    for (int step = 0; step < STEPS; ++step) {
+        const int center = (step * span) / (STEPS - 1);
+        for (int ring = 0; ring < RINGS; ++ring) {
+            int distance = ring * 256 - center;
+            distance = distance < 0 ? -distance : distance;
+            // neighbouring rings glow at ~40%, like the old 0.4f/0.7f steps
+            int weight = 255 - (distance * 155) / 256;
+            table.weights[step][ring] = weight < 64 ? 64 : weight;
+        }
+    }
+    return table;
+}
+
+// The hour hand is on the outer ring and the minute hand on all the others
+template <typename Geometry>
+struct HandRings {
+    uint8_t hour[Geometry::NUM_RINGS];
+    uint8_t minute[Geometry::NUM_RINGS];
+};
+
+template <typename Geometry>
+static constexpr HandRings<Geometry> BuildHandRings() {
+    HandRings<Geometry> rings{};
+    for (int ring = 0; ring < Geometry::NUM_RINGS; ++ring) {
+        rings.hour[ring] = ring == 0 ? 255 : 0;
+        rings.minute[ring] = ring == 0 ? 0 : 255;
+    }
+    return rings;
+}
+
+static constexpr std::array<uint8_t, 256> CROSSFADE = BuildCrossfadeTable();
+
+template <typename Geometry>
+static constexpr SubsecondTable<Geometry> SUBSECOND =
+    BuildSubsecondTable<Geometry>();
+
+template <typename Geometry>
+static constexpr HandRings<Geometry> HAND_RINGS = BuildHandRings<Geometry>();
+
+template <typename Geometry>
+void BasicAnalogRings<Geometry>::DrawHands(BasicPixels<Geometry>& pixels,
+                                           const int hour12,
+                                           const int minute,
+                                           const int second,
+                                           const int millis,
+                                           const RgbColor hourColor,
+                                           const RgbColor minuteColor,
+                                           const RgbColor secondColor) {
+    const int step = (millis * SUBSECOND_STEPS) / 1000;
+    DrawHand(pixels, GetSecondPos(second, millis), secondColor,
+             SUBSECOND<Geometry>.weights[step < SUBSECOND_STEPS ? step : 0]);
+    DrawHand(pixels, GetMinutePos(minute, second), minuteColor,
+             HAND_RINGS<Geometry>.minute);
+    DrawHand(pixels, GetHourPos(hour12, minute), hourColor,
+             HAND_RINGS<Geometry>.hour);
+}
+
+template <typename Geometry>
+void BasicAnalogRings<Geometry>::DrawHand(BasicPixels<Geometry>& pixels,
+                                          const uint32_t pos,
+                                          const RgbColor color,
+                                          const RingWeights& ringWeights) {
+    const int led = (pos / POS_PER_LED) % Geometry::RING_SIZE;
+    const int nextLed = (led + 1) % Geometry::RING_SIZE;
+    const uint8_t progress = pos % POS_PER_LED;
+    const uint8_t ledWeight = CROSSFADE[255 - progress];
+    const uint8_t nextLedWeight = CROSSFADE[progress];
+
+    for (int ring = 0; ring < Geometry::NUM_RINGS; ++ring) {
+        if (ringWeights[ring] == 0) {
+            continue;
+        }
+        const uint8_t weight = (ledWeight * ringWeights[ring]) / 255;
+        const uint8_t nextWeight = (nextLedWeight * ringWeights[ring]) / 255;
+        if (weight >= MIN_WEIGHT) {
+            pixels.DrawRingLED(ring, led,
+                               RgbColor::LinearBlend(BLACK, color, weight));
+        }
+        if (nextWeight >= MIN_WEIGHT) {
+            pixels.DrawRingLED(
+                ring, nextLed, RgbColor::LinearBlend(BLACK, color, nextWeight));
+        }
+    }
+}
+
+// LED 0 is at 1:00, so every position is shifted back by one LED
+
+template <typename Geometry>
+uint32_t BasicAnalogRings<Geometry>::GetHourPos(const int hour12,
+                                                const int minute) {
+    const uint32_t minutes = (hour12 % 12) * 60 + minute;  // of 720
+    return (minutes * POS_PER_RING / 720 + POS_PER_RING - POS_PER_LED) %
+           POS_PER_RING;
+}
+
+template <typename Geometry>
+uint32_t BasicAnalogRings<Geometry>::GetMinutePos(const int minute,
+                                                  const int second) {
+    const uint32_t seconds = minute * 60 + second;  // of 3600
+    return (seconds * POS_PER_RING / 3600 + POS_PER_RING - POS_PER_LED) %
+           POS_PER_RING;
+}
+
+template <typename Geometry>
+uint32_t BasicAnalogRings<Geometry>::GetSecondPos(const int second,
+                                                  const int millis) {
+    const uint32_t ms = second * 1000 + millis;  // of 60000
+    return (ms * POS_PER_RING / 60000 + POS_PER_RING - POS_PER_LED) %
+           POS_PER_RING;
+}
+
+template class BasicAnalogRings<ActiveGeometry>;
+#endif
@@ -10,6 +10,11 @@ Animator::Animator() {
 }
 
 void Animator::Update() {
+    UpdateColors();
+    DrawBackground();
+}
+
+void Animator::UpdateColors() {
     if (freq > 0 && sinceLastAnimation.Ms() > freq) {
         sinceLastAnimation.Reset();
         if (func) {
@@ -18,6 +23,15 @@ void Animator::Update() {
     }
 }
 
+void Animator::DrawBackground() {
+    if (drawFreq > 0 && sinceLastDraw.Ms() > drawFreq) {
+        sinceLastDraw.Reset();
+        if (draw) {
+            draw(*this);
+        }
+    }
+}
+
 void Animator::Start() {
     if (!(*settings).containsKey("COLR")) {
         (*settings)["COLR"] = wheelPos;
@@ -95,6 +109,7 @@ bool Animator::CanChangeColor() {
 void RainbowFixed::Start() {
     name = "Rainbow Fixed";
     freq = 50;
+    hasFixedColors = true;
     func = [&](Animator& a) {
         uint8_t tempPos = wheelPos;
         for (size_t i = 0; i < digitColors.size(); i++) {
@@ -390,6 +405,7 @@ void IndividualDigitColors::Start() {
     }
 
     freq = 50;
+    hasFixedColors = true;
     func = [&](Animator& a) {
         digitColors[0] = GetSelectedDigitColor(0);  // col0
         digitColors[1] = GetSelectedDigitColor(1);  // col1
@@ -524,18 +540,21 @@ void RainbowFixedMatrix::Start() {
             d = Pixels::ColorWheel(wheelPos);
             d.Lighten(40);
         }
+    };
 
+    drawFreq = 10;
+    draw = [&](Animator& a) {
         auto animateDot = [&](MatrixDot& dot) {
             if (dot.time.Ms() >= dot.period || dot.period == 0) {
                 dot.time.Reset();
 #if FCOS_CARDCLOCK || FCOS_CARDCLOCK2
-                if (++dot.y == DISPLAY_HEIGHT || dot.period == 0) {
-                    dot.x = rand() % DISPLAY_WIDTH;
-                    dot.y = dot.period == 0 ? rand() % DISPLAY_HEIGHT : 0;
+                if (++dot.y == Geometry::HEIGHT || dot.period == 0) {
+                    dot.x = rand() % Geometry::WIDTH;
+                    dot.y = dot.period == 0 ? rand() % Geometry::HEIGHT : 0;
                     dot.period = 50 + (rand() % 225);
 #else
-                if (++dot.x == TOTAL_MATRIX_LEDS || dot.period == 0) {
-                    dot.x = rand() % TOTAL_MATRIX_LEDS;
+                if (++dot.x == Geometry::MATRIX_LEDS || dot.period == 0) {
+                    dot.x = rand() % Geometry::MATRIX_LEDS;
                     dot.y = 0;
                     dot.period = 20 + (rand() % 200);
 #endif
@@ -564,9 +583,12 @@ void HolidayLights::Start() {
             d = Pixels::ColorWheel(tempPos + 128);
             // tempPos += 64;
         }
+    };
 
+    drawFreq = 10;
+    draw = [&](Animator& a) {
         struct PerimeterDot {
-            int8_t x{-1}, y{DISPLAY_HEIGHT};
+            int8_t x{-1}, y{Geometry::HEIGHT};
             int8_t xDir{0}, yDir{0};
             RgbColor color{BLACK};
             ElapsedTime time;
@@ -597,21 +619,21 @@ void HolidayLights::Start() {
                 dot.x += dot.xDir;
                 dot.y += dot.yDir;
 
-                if (dot.x == DISPLAY_WIDTH) {
+                if (dot.x == Geometry::WIDTH) {
                     dot.xDir = 0;
                     dot.yDir = 1;
-                    dot.x = DISPLAY_WIDTH - 1;
+                    dot.x = Geometry::WIDTH - 1;
                     dot.y = 1;
-                } else if (dot.y == DISPLAY_HEIGHT) {
+                } else if (dot.y == Geometry::HEIGHT) {
                     dot.xDir = -1;
                     dot.yDir = 0;
-                    dot.x = DISPLAY_WIDTH - 2;
-                    dot.y = DISPLAY_HEIGHT - 1;
+                    dot.x = Geometry::WIDTH - 2;
+                    dot.y = Geometry::HEIGHT - 1;
                 } else if (dot.x == -1) {
                     dot.xDir = 0;
                     dot.yDir = -1;
                     dot.x = 0;
-                    dot.y = DISPLAY_HEIGHT - 2;
+                    dot.y = Geometry::HEIGHT - 2;
                 } else if (dot.y == -1) {
                     dot.xDir = 1;
                     dot.yDir = 0;
@@ -628,7 +650,7 @@ void HolidayLights::Start() {
     };
 }
 
-Starfield::Starfield() : Animator() {
+Starfield::Starfield() : Animator(), trail(TRAIL_HALF_LIFE_MS) {
     name = "Warp Speed";
 }
 
@@ -636,7 +658,7 @@ void Starfield::Start() {
     stars.resize(7);
     
     // Set animation frequency (update every 15ms for smooth animation)
-    freq = 15;
+    drawFreq = 15;
     
     // Load color from settings
     if (!(*settings).containsKey("COLR")) {
@@ -650,13 +672,8 @@ void Starfield::Start() {
         d = Pixels::ColorWheel(wheelPos);
     }
     
-    // Set the colon color
-    (*settings)["COLR_COLON"] = wheelPos;
-    
     // Define the animation function
-    func = [&](Animator& a) {
-        // Don't clear the display - rely on natural fading from Clock class
-        
+    draw = [&](Animator& a) {
         // Update and draw each star
         for (auto& star : stars) {
             // Update star position
@@ -667,21 +684,18 @@ void Starfield::Start() {
                 star.Reset();
             }
             
-            // Draw the star at its current position
-            // Use integer casting for the pixel coordinates
-            int pixelX = static_cast<int>(star.x);
-            int pixelY = static_cast<int>(star.y);
-            
-            // Only draw if within bounds (should be redundant with IsOutOfBounds check)
-            if (pixelX >= 0 && pixelX < DISPLAY_WIDTH && pixelY >= 0 && pixelY < DISPLAY_HEIGHT) {
-                // Always use white stars with varying brightness
-                pixels->Set(pixelX, pixelY, star.color);
-            }
+            // Draw the star at its exact position, so slow stars glide
+            // between LEDs instead of jumping
+            trail.Splat(star.x, star.y, star.color);
         }
+
+        // the trail fades the previous positions into streaks
+        pixels->ComposeLayer(trail);
     };
 }
 
-SnowfallAnimator::SnowfallAnimator() : Animator() {
+SnowfallAnimator::SnowfallAnimator()
+    : Animator(), trail(TRAIL_HALF_LIFE_MS) {
     name = "Snowfall";
 }
 
@@ -690,7 +704,7 @@ void SnowfallAnimator::Start() {
     snowflakes.resize(14);
     
     // Initialize snow piles for accumulation
-    snowPiles.resize(DISPLAY_WIDTH);
+    snowPiles.resize(Geometry::WIDTH);
     for (auto& pile : snowPiles) {
         pile.Reset();
         pile.height = 0; // Start with no snow
@@ -702,7 +716,7 @@ void SnowfallAnimator::Start() {
     windChangeTimer.Reset();
     
     // Set animation frequency (update every 20ms for smoother animation)
-    freq = 20;
+    drawFreq = 20;
     
     // Load snow color from settings or use default
     if (!(*settings).containsKey("SNOW_COLOR")) {
@@ -731,16 +745,10 @@ void SnowfallAnimator::Start() {
         d = Pixels::ColorWheel(wheelPos);
     }
     
-    // Set the colon color
-    (*settings)["COLR_COLON"] = wheelPos;
-    
-    // Create a display buffer to reduce flickering
-    displayBuffer.resize(DISPLAY_WIDTH * DISPLAY_HEIGHT, BLACK);
-    
     // Initialize snowflakes with random positions to avoid all starting at the top
     for (auto& flake : snowflakes) {
-        flake.x = (float)(rand() % DISPLAY_WIDTH);
-        flake.y = (float)(rand() % DISPLAY_HEIGHT);
+        flake.x = (float)(rand() % Geometry::WIDTH);
+        flake.y = (float)(rand() % Geometry::HEIGHT);
         flake.speed = (float)(rand() % 50) / 100.0f + 0.1f;  // 0.1 to 0.6
         flake.size = (float)(rand() % 60) / 100.0f + 0.4f;  // 0.4 to 1.0
         
@@ -749,21 +757,7 @@ void SnowfallAnimator::Start() {
     }
     
     // Define the animation function
-    func = [&](Animator& a) {
-        // Apply a gentle fade to the entire buffer to create trails
-        for (int i = 0; i < DISPLAY_WIDTH * DISPLAY_HEIGHT; i++) {
-            // Fade existing pixels slightly to create a trail effect
-            if (displayBuffer[i].R > 0 || displayBuffer[i].G > 0 || displayBuffer[i].B > 0) {
-                // Apply a very slight fade to existing pixels (0.85 for longer trails)
-                displayBuffer[i] = Pixels::ScaleBrightness(displayBuffer[i], 0.85f);
-                
-                // If pixel is too dim, turn it off completely
-                if (displayBuffer[i].R < 5 && displayBuffer[i].G < 5 && displayBuffer[i].B < 5) {
-                    displayBuffer[i] = BLACK;
-                }
-            }
-        }
-        
+    draw = [&](Animator& a) {
         // Update wind with smoother transitions
         if (windChangeTimer.Ms() >= windChangeDuration) {
             windChangeTimer.Reset();
@@ -786,7 +780,7 @@ void SnowfallAnimator::Start() {
                 int pileX = static_cast<int>(flake.x);
                 
                 // Ensure pileX is within bounds
-                if (pileX >= 0 && pileX < DISPLAY_WIDTH) {
+                if (pileX >= 0 && pileX < Geometry::WIDTH) {
                     // Only add to pile if it's not too high (max 3 lines)
                     if (snowPiles[pileX].height < 3) {
                         snowPiles[pileX].height++;
@@ -800,19 +794,14 @@ void SnowfallAnimator::Start() {
                 flake.color = CalculateSnowColor(snowBrightness);
             }
             
-            // Draw the snowflake at its current position
-            int pixelX = static_cast<int>(flake.x);
-            int pixelY = static_cast<int>(flake.y);
-            
-            // Only draw if within bounds
-            if (pixelX >= 0 && pixelX < DISPLAY_WIDTH && pixelY >= 0 && pixelY < DISPLAY_HEIGHT) {
-                // Add to buffer - just use the snowflake's color (no glow effect)
-                displayBuffer[pixelY * DISPLAY_WIDTH + pixelX] = flake.color;
-            }
+            // Draw the snowflake at its exact position, so slow flakes drift
+            // smoothly between LEDs - just use the snowflake's color (no glow
+            // effect)
+            trail.Splat(flake.x, flake.y, flake.color);
         }
         
         // Draw and update snow piles
-        for (int x = 0; x < DISPLAY_WIDTH; x++) {
+        for (int x = 0; x < Geometry::WIDTH; x++) {
             auto& pile = snowPiles[x];
             
             // Check if pile should melt - faster melting (2500-5000ms instead of 5000-10000ms)
@@ -824,23 +813,19 @@ void SnowfallAnimator::Start() {
             
             // Draw the snow pile
             for (int h = 0; h < pile.height; h++) {
-                int y = DISPLAY_HEIGHT - 1 - h;
-                if (y >= 0 && y < DISPLAY_HEIGHT) {
+                int y = Geometry::HEIGHT - 1 - h;
+                if (y >= 0 && y < Geometry::HEIGHT) {
                     // Use slightly different shades based on current settings
                     float brightness = 0.7f + ((float)(rand() % 30) / 100.0f);
                     RgbColor pileColor = CalculateSnowColor(snowBrightness);
-                    // Add to buffer
-                    displayBuffer[y * DISPLAY_WIDTH + x] = pileColor;
+                    // Add to the trail
+                    trail.Set(x, y, pileColor);
                 }
             }
         }
         
-        // Draw the buffer to the display
-        for (int y = 0; y < DISPLAY_HEIGHT; y++) {
-            for (int x = 0; x < DISPLAY_WIDTH; x++) {
-                pixels->Set(x, y, displayBuffer[y * DISPLAY_WIDTH + x]);
-            }
-        }
+        // Draw the trail to the display, which also fades it
+        pixels->ComposeLayer(trail);
     };
 }
 
@@ -913,6 +898,71 @@ RgbColor SnowfallAnimator::CalculateSnowColor(float brightness) {
     
     return color;
 }
+
+GameOfLife::GameOfLife() : Animator(), cells(DEATH_HALF_LIFE_MS) {
+    name = "Life";
+}
+
+void GameOfLife::Start() {
+    Animator::Start();
+    drawFreq = 1;  // redraw every frame so the births can fade in
+
+    // SetColor() calls Start() again, which shouldn't restart the board
+    if (board.Population() == 0) {
+        Seed();
+    }
+
+    draw = [&](Animator& a) {
+        if (sinceGeneration.Ms() >= GENERATION_MS) {
+            Step();
+        }
+
+        // cells use the opposite side of the color wheel from the digits.
+        // newborns fade in over one generation, while cells that died are
+        // no longer drawn into the layer, which fades them out
+        const RgbColor color =
+            ShaderMath::Dim(ShaderMath::Hue(wheelPos + 128), CELL_LEVEL);
+        const uint8_t birth =
+            std::min<size_t>(255, sinceGeneration.Ms() * 255 / GENERATION_MS);
+        const RgbColor newborn = ShaderMath::Dim(color, birth);
+
+        for (int y = 0; y < Geometry::HEIGHT; ++y) {
+            for (int w = 0; w < Board::WORDS; ++w) {
+                const Board::Word live = board.GetRow(y)[w];
+                const Board::Word born = live & ~previous.GetRow(y)[w];
+                for (Board::Word alive = live; alive; alive &= alive - 1) {
+                    const int bit = __builtin_ctz(alive);
+                    cells.Set(w * Board::WORD_BITS + bit, y,
+                              ((born >> bit) & 1) ? newborn : color);
+                }
+            }
+        }
+        pixels->ComposeLayer(cells);
+    };
+}
+
+void GameOfLife::Seed() {
+    board.Clear();
+    for (int y = 0; y < Geometry::HEIGHT; ++y) {
+        for (int x = 0; x < Geometry::WIDTH; ++x) {
+            board.Set(x, y, rand() % 100 < SEED_PERCENT);
+        }
+    }
+    generations = 0;
+}
+
+void GameOfLife::Step() {
+    sinceGeneration.Reset();
+    older = previous;
+    previous = board;
+    board.Step();
+
+    // still lifes and blinkers would otherwise sit there forever
+    if (board == previous || board == older || board.Population() < 3 ||
+        ++generations >= MAX_GENERATIONS) {
+        Seed();
+    }
+}
 #endif
 
 RgbColor Animator::GetAdjustedDigitColor(size_t index) {
@@ -1,3 +1,4 @@
+#include <algorithm>  // for std::min
 #include <button.hpp>
 Button::Button(const int pin) : m_pin(pin) {
 #if ARDUINO
@@ -62,6 +63,32 @@ void Button::SendEvent(const Event_e evt) {
     m_pressEventSent = m_isPressed;
 }
 
+size_t Button::GetMsUntilTimedEvent() const {
+    const auto until = [](const size_t elapsedMs, const size_t dueMs) {
+        return elapsedMs >= dueMs ? 0 : dueMs - elapsedMs;
+    };
+    size_t ms = EventFlags::FOREVER;
+    if (!m_enabled) {
+        return ms;
+    }
+    const size_t inStateMs = m_etInState.Ms();
+    if (m_debouncing) {
+        ms = until(inStateMs, config.debounceTime);
+    }
+    if (m_isPressed && !m_pressEventSent && MustDelayBeforePress()) {
+        ms = std::min(ms, until(inStateMs, config.beforePress));
+    }
+    if (m_isPressed && m_pressEventSent && !m_longPressEventSent) {
+        ms = std::min(ms, until(inStateMs, config.longPressTime));
+    }
+    if (m_isPressed && m_pressEventSent && config.canRepeat) {
+        ms = std::min(ms, std::max(until(inStateMs, config.beforeRepeat),
+                                   until(m_etSinceRepeat.Ms(),
+                                         config.repeatRate)));
+    }
+    return ms;
+}
+
 bool Button::MustDelayBeforePress() const {
     return config.beforePress > 0;
 }
@@ -110,6 +137,18 @@ Joystick::Joystick() {
     m_buttons.push_back(&left);
     m_buttons.push_back(&right);
     m_buttons.push_back(&press);
+
+#if ARDUINO
+    LoopEvents();  // created before the ISR can use it
+    for (Button* btn : m_buttons) {
+        attachInterrupt(digitalPinToInterrupt(btn->GetPin()), OnPinChange,
+                        CHANGE);
+    }
+#endif
+}
+
+void IRAM_ATTR Joystick::OnPinChange() {
+    LoopEvents().SetFromISR(EVENT_BUTTON);
 }
 
 int Joystick::AreAnyButtonsPressed() {
@@ -130,20 +169,31 @@ int Joystick::AreAnyButtonsPressed() {
 
 bool Joystick::WaitForButton(const Button& btn, const int ms) {
     ElapsedTime elapsed;
-    while (elapsed.Ms() < ms || ms == -1) {
+    for (;;) {
         Update();
         if (btn.IsPressed()) {
             return false;
         }
-        ElapsedTime::Delay(1);
+        if (ms != -1 && elapsed.Ms() >= (size_t)ms) {
+            return true;
+        }
+        WaitForInput(ms == -1 ? (size_t)EventFlags::FOREVER
+                              : ms - elapsed.Ms());
     }
-    return true;
 }
 
 void Joystick::WaitForNoButtonsPressed() {
     while (AreAnyButtonsPressed() != -1) {
-        ElapsedTime::Delay(1);
+        WaitForInput(EventFlags::FOREVER);
+    }
+}
+
+bool Joystick::WaitForInput(const size_t timeoutMs) {
+    size_t waitMs = timeoutMs;
+    for (Button* btn : m_buttons) {
+        waitMs = std::min(waitMs, btn->GetMsUntilTimedEvent());
     }
+    return LoopEvents().Wait(EVENT_BUTTON, waitMs) != 0;
 }
 
 void Joystick::Reset() {
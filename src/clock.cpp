@@ -1,52 +1,225 @@
 #include <clock.hpp>
 
+void Clock::Initialize() {
+    m_saveTimer = m_timers->Add([&]() {
+        ElapsedTime saveTime;
+        m_settings->Save();
+        TDPRINT(m_rtc, "Saved settings in %dms                          \n",
+                saveTime.Ms());  // usually ~25ms
+    });
+}
+
 void Clock::Activate() {
     LoadSettings();
+    m_transition.active = false;
+    m_transition.from.reset();
+    std::fill(std::begin(m_shownDigits), std::end(m_shownDigits), 0);
     SetAnimator(CreateAnimator(m_pixels, m_settings, m_rtc,
                                (AnimatorType_e)m_animMode));
+    UpdateBackground();
 }
 
 void Clock::Update() {
+    m_pixels->GetFrameStats().SetBucket(m_statsBucket);
     auto wheelPos = (*m_settings)["COLR"].as<uint8_t>();
     RgbColor color = wheelPos;
     m_currentColor = color;
     m_pixels->Darken();
 #if FCOS_FOXIECLOCK
-    m_anim->Update();
+    UpdateAnimators();
     DrawClockDigits(m_currentColor);
 #elif FCOS_CARDCLOCK || FCOS_CARDCLOCK2
-    m_anim->Update();
+    UpdateAnimators();
     if (!m_pixels->IsDarkModeEnabled() || m_pixels->GetBrightness() >= 0.05f) {
         m_pixels->ClearRoundLEDs({1, 1, 1});
     }
 
-    int brightestLED = 0;
-    if (m_rtc->Millis() >= 666)
-        brightestLED = 2;
-    else if (m_rtc->Millis() >= 333)
-        brightestLED = 1;
-
-    m_pixels->DrawSecondLEDs(m_rtc->Second(), m_anim->digitColors[0],
-                             brightestLED);
-
-    m_pixels->DrawMinuteLED(m_rtc->Minute(), m_anim->digitColors[1]);
-    m_pixels->DrawHourLED(m_rtc->Hour12(), m_anim->GetColonColor());
+    AnalogRings::DrawHands(
+        *m_pixels, m_rtc->Hour12(), m_rtc->Minute(), m_rtc->Second(),
+        m_rtc->Millis(),
+        TransitionColor([](DigitColorSource& a) { return a.GetColonColor(); }),
+        TransitionColor(
+            [](DigitColorSource& a) { return a.GetDigitColor(1); }),
+        TransitionColor(
+            [](DigitColorSource& a) { return a.GetDigitColor(0); }));
     DrawClockDigits(m_currentColor);
 
 #endif
+}
 
-    CheckIfWaitingToSaveSettings();
+void Clock::ApplyProfile(const PowerProfile& profile) {
+    m_profileAnimation = profile.animation;
+    const size_t lastMode = m_animMode;
+    LoadSettings();
+    // when hidden, Activate() picks up the new mode
+    if (m_anim && m_animMode != lastMode && m_manager &&
+        m_manager->GetActive().get() == this) {
+        StartTransition(CreateAnimator(m_pixels, m_settings, m_rtc,
+                                       (AnimatorType_e)m_animMode));
+        UpdateBackground();
+    }
+}
+
+bool Clock::IsStaticUntilNextTick() {
+    if (!m_anim) {
+        return false;
+    }
+    // with a BG animator, m_anim only provides the colors
+    bool isAnimating = m_background ? m_background->IsBackgroundAnimating()
+                                    : m_anim->IsBackgroundAnimating();
+    isAnimating = isAnimating || m_anim->AreColorsAnimating();
+
+    bool isTransitioning = m_transition.active;
+    for (const auto& transition : m_digitTransitions) {
+        isTransitioning = isTransitioning || transition.IsActive();
+    }
+#if FCOS_CARDCLOCK || FCOS_CARDCLOCK2
+    const bool hasSweepingHands = true;
+#else
+    const bool hasSweepingHands = false;
+#endif
+    return m_face.IsStaticUntilNextTick(
+        {isAnimating, isTransitioning, hasSweepingHands, m_isBreathShown});
 }
 
 void Clock::SetAnimator(std::shared_ptr<Animator> anim) {
     m_anim = anim;
     m_anim->Start();
     m_anim->SetColor((*m_settings)["COLR"].as<uint8_t>());
+    UpdateStatsBucket();
+}
+
+void Clock::StartTransition(std::shared_ptr<Animator> anim) {
+    if (!(*m_settings).containsKey("ANIM_XFADE_MS")) {
+        (*m_settings)["ANIM_XFADE_MS"] = (int)CROSSFADE_MS_DEFAULT;
+    }
+    const size_t durationMs = (*m_settings)["ANIM_XFADE_MS"].as<size_t>();
+    if (durationMs == 0 || !m_anim) {
+        m_transition.active = false;
+        m_transition.from.reset();
+        SetAnimator(anim);
+        return;
+    }
+
+    // the outgoing animator continues from whatever is on the LEDs right now
+    m_transition.from = m_anim;
+    m_pixels->CopyMatrixTo(m_transition.fromBuffer);
+    m_transition.toBuffer.assign(Pixels::Shape::MATRIX_LEDS, BLACK);
+    m_transition.durationMs = durationMs;
+    m_transition.amount = 0;
+    m_transition.elapsed.Reset();
+    m_transition.active = true;
+    SetAnimator(anim);
+}
+
+void Clock::UpdateBackground() {
+    if (!(*m_settings).containsKey("BG")) {
+        (*m_settings)["BG"] = 0;
+    }
+    // 0, or the same mode as ANIM, means ANIM draws its own background
+    const int mode = (*m_settings)["BG"].as<int>() - 1;
+    if (mode < 0 || mode >= ANIM_TOTAL || mode == (int)m_animMode) {
+        m_background.reset();
+        m_backgroundMode = -1;
+        UpdateStatsBucket();
+        return;
+    }
+    if (mode == m_backgroundMode) {
+        return;
+    }
+
+    m_backgroundMode = mode;
+    m_background =
+        CreateAnimator(m_pixels, m_settings, m_rtc, (AnimatorType_e)mode);
+    m_background->Start();
+    m_backgroundLayer.Clear();
+    m_background->SetBackgroundColor((*m_settings)["COLR"].as<uint8_t>());
+    UpdateStatsBucket();
+}
+
+void Clock::UpdateStatsBucket() {
+    m_statsBucket = (m_name + "/" + m_anim->name).c_str();
+    if (m_background) {
+        m_statsBucket += "+";
+        m_statsBucket += m_background->GetName().c_str();
+    }
+}
+
+void Clock::UpdateAnimators() {
+    auto& t = m_transition;
+    if (t.active && t.elapsed.Ms() >= t.durationMs) {
+        t.active = false;
+        t.from.reset();
+    }
+
+    if (m_background) {
+        // the background doesn't change with ANIM, so only the digit
+        // colors need to cross-fade, which TransitionColor() does. It draws
+        // into a Layer of its own, which fades by itself in between draws
+        // rather than with the Darken() of every frame.
+        m_pixels->SetLayerTarget(&m_backgroundLayer);
+        m_background->DrawBackground();
+        m_pixels->SetLayerTarget(nullptr);
+        m_pixels->ComposeLayer(m_backgroundLayer);
+        if (t.active) {
+            t.amount = (t.elapsed.Ms() * 255) / t.durationMs;
+            t.from->UpdateColors();
+        }
+        m_anim->UpdateColors();
+        return;
+    }
+
+    if (!t.active) {
+        m_anim->Update();
+        return;
+    }
+
+    t.amount = (t.elapsed.Ms() * 255) / t.durationMs;
+
+    // each animator only sees its own buffer, including the fading that the
+    // Clock would normally apply to the LEDs
+    m_pixels->SetRenderTarget(&t.fromBuffer);
+    m_pixels->Darken();
+    t.from->Update();
+
+    m_pixels->SetRenderTarget(&t.toBuffer);
+    m_pixels->Darken();
+    m_anim->Update();
+
+    m_pixels->SetRenderTarget(nullptr);
+    m_pixels->BlendMatrix(t.fromBuffer, t.toBuffer, t.amount);
+}
+
+RgbColor Clock::TransitionColor(
+    const std::function<RgbColor(DigitColorSource& a)>& get) {
+    RgbColor color = get(*m_anim);
+    if (m_transition.active) {
+        color = RgbColor::LinearBlend(get(*m_transition.from), color,
+                                      m_transition.amount);
+    }
+    return color;
+}
+
+RgbColor Clock::DigitColor(const size_t index, const bool end) {
+    return TransitionColor([&](DigitColorSource& a) {
+        return end ? a.GetAdjustedDigitColorEnd(index)
+                   : a.GetAdjustedDigitColor(index);
+    });
+}
+
+RgbColor Clock::ColonColor(const bool end) {
+    return TransitionColor([&](DigitColorSource& a) {
+        return end ? a.GetAdjustedColonColorEnd() : a.GetAdjustedColonColor();
+    });
 }
 
 void Clock::Up(const Button::Event_e evt) {
     if (evt == Button::PRESS || evt == Button::REPEAT) {
         m_anim->Up();
+        if (m_background) {
+            m_background->SetBackgroundColor(
+                (*m_settings)["COLR"].as<uint8_t>());
+        }
         PrepareToSaveSettings();
     }
 };
@@ -54,6 +227,10 @@ void Clock::Up(const Button::Event_e evt) {
 void Clock::Down(const Button::Event_e evt) {
     if (evt == Button::PRESS || evt == Button::REPEAT) {
         m_anim->Down();
+        if (m_background) {
+            m_background->SetBackgroundColor(
+                (*m_settings)["COLR"].as<uint8_t>());
+        }
         PrepareToSaveSettings();
     }
 };
@@ -87,9 +264,10 @@ void Clock::Press(const Button::Event_e evt) {
         if (++m_animMode >= ANIM_TOTAL) {
             m_animMode = 0;
         }
-        SetAnimator(CreateAnimator(m_pixels, m_settings, m_rtc,
-                                   (AnimatorType_e)m_animMode));
+        StartTransition(CreateAnimator(m_pixels, m_settings, m_rtc,
+                                       (AnimatorType_e)m_animMode));
         (*m_settings)["ANIM"] = m_animMode + 1;
+        UpdateBackground();
         m_pixels->Clear();
         Joystick joy;
 #if FCOS_CARDCLOCK2
@@ -108,6 +286,8 @@ void Clock::Press(const Button::Event_e evt) {
         joy.WaitForButton(joy.press, 500);
 #endif
         joy.WaitForNoButtonsPressed();
+        // the cross-fade begins once the new mode's name has been shown
+        m_transition.elapsed.Reset();
         PrepareToSaveSettings();
     } else if (evt == Button::LONG_PRESS) {
         m_pixels->ToggleDarkMode();
@@ -124,11 +304,11 @@ void Clock::DrawClockDigits(const RgbColor color) {
     }
     int yPos = 0;
 #if FCOS_FOXIECLOCK
-    m_pixels->DrawChar(0, text[0], m_anim->GetAdjustedDigitColor(0), m_anim->GetAdjustedDigitColorEnd(0));
-    m_pixels->DrawChar(20, text[1], m_anim->GetAdjustedDigitColor(1), m_anim->GetAdjustedDigitColorEnd(1));
-    //                         [2] is the colon
-    m_pixels->DrawChar(42, text[3], m_anim->GetAdjustedDigitColor(2), m_anim->GetAdjustedDigitColorEnd(2));
-    m_pixels->DrawChar(62, text[4], m_anim->GetAdjustedDigitColor(3), m_anim->GetAdjustedDigitColorEnd(3));
+    DrawDigit(0, 0, yPos, text[0]);
+    DrawDigit(1, 20, yPos, text[1]);
+    //           [2] is the colon
+    DrawDigit(2, 42, yPos, text[3]);
+    DrawDigit(3, 62, yPos, text[4]);
 
     if ((m_pixels->GetBrightness() >= 0.05f || (*m_settings)["MINB"] != "0")) {
     }
@@ -136,42 +316,60 @@ void Clock::DrawClockDigits(const RgbColor color) {
 #if FCOS_CARDCLOCK2
     yPos = 3;
 #endif
-    m_pixels->DrawChar(0, yPos, text[0], m_anim->GetAdjustedDigitColor(0), m_anim->GetAdjustedDigitColorEnd(0));
-    m_pixels->DrawChar(4, yPos, text[1], m_anim->GetAdjustedDigitColor(1), m_anim->GetAdjustedDigitColorEnd(1));
-    //                         [2] is the colon
-    m_pixels->DrawChar(10, yPos, text[3], m_anim->GetAdjustedDigitColor(2), m_anim->GetAdjustedDigitColorEnd(2));
-    m_pixels->DrawChar(14, yPos, text[4], m_anim->GetAdjustedDigitColor(3), m_anim->GetAdjustedDigitColorEnd(3));
+    DrawDigit(0, 0, yPos, text[0]);
+    DrawDigit(1, 4, yPos, text[1]);
+    //           [2] is the colon
+    DrawDigit(2, 10, yPos, text[3]);
+    DrawDigit(3, 14, yPos, text[4]);
 #endif  // FCOS_CARDCLOCK || FCOS_CARDCLOCK2
-    if (!m_pixels->IsDarkModeEnabled() || m_pixels->GetBrightness() >= 0.05f) {
-        DrawSeparator(8, m_anim->GetAdjustedColonColor());
+    m_isBreathShown =
+        !m_pixels->IsDarkModeEnabled() || m_pixels->GetBrightness() >= 0.05f;
+    if (m_isBreathShown) {
+        DrawSeparator(8, ColonColor());
     } else {
 #if FCOS_FOXIECLOCK
         // m_pixels->DrawChar(8, yPos, ':', m_anim->GetColonColor());
 #elif FCOS_CARDCLOCK || FCOS_CARDCLOCK2
-        m_pixels->DrawChar(8, yPos, ':', m_anim->GetAdjustedColonColor(), m_anim->GetAdjustedColonColorEnd());
+        m_pixels->DrawChar(8, yPos, ':', ColonColor(), ColonColor(true));
 #endif
     }
 }
 
-void Clock::DrawSeparator(const int x, RgbColor color) {
-    if (m_rtc->Second() % 2 && !m_blinkerRunning) {
-        m_blinkerRunning = true;
-        m_blinkerTimer.Reset();
+void Clock::DrawDigit(const size_t index,
+                      const int x,
+                      const int y,
+                      const char character) {
+    auto& transition = m_digitTransitions[index];
+    if (character != m_shownDigits[index]) {
+        // transitions need individual pixels, which FC2 edge-lit mode lacks
+        if (m_shownDigits[index] != 0 && m_pixels->IsPXLModeEnabled()) {
+            transition.Start(m_shownDigits[index], character,
+                             GetDigitTransitionStyle());
+        }
+        m_shownDigits[index] = character;
     }
+
+    if (transition.IsActive()) {
+        transition.Update(GetManager()->GetFrameDeltaMs());
+        transition.Draw(*m_pixels, x, y, DigitColor(index),
+                        DigitColor(index, true));
+    } else {
+        m_pixels->DrawChar(x, y, character, DigitColor(index),
+                           DigitColor(index, true));
+    }
+}
+
+void Clock::DrawSeparator(const int x, RgbColor color) {
+    const float progress =
+        m_face.UpdateBreath(m_rtc->Second(), m_rtc->Millis(), millis());
     const auto scale = &Pixels::ScaleBrightness;
-    RgbColor bottomColor = m_anim->GetAdjustedColonColor();
+    RgbColor bottomColor = color;
     RgbColor topColor = bottomColor;
 
-    if (m_blinkerRunning) {
-        const float progress = m_blinkerTimer.Ms() / 1900.0f;
+    if (progress >= 0) {
         float brightness = progress < 0.5f ? progress : 1.0f - progress;
         bottomColor = scale(bottomColor, 0.55f - brightness);
         topColor = scale(topColor, 0.05f + brightness);
-
-        if (m_blinkerTimer.Ms() >= 1900 ||
-            (!(m_rtc->Second() % 2) && m_rtc->Millis() > 900)) {
-            m_blinkerRunning = false;
-        }
     } else {
         bottomColor = scale(bottomColor, 0.55f);
         topColor = scale(topColor, 0.05f);
@@ -189,23 +387,16 @@ void Clock::DrawSeparator(const int x, RgbColor color) {
 #endif
 }
 
-void Clock::PrepareToSaveSettings() {
-    m_shouldSaveSettings = true;
-    m_waitingToSaveSettings.Reset();
+DigitTransition::Style_e Clock::GetDigitTransitionStyle() {
+    const int style = (*m_settings)["DIGIT_FX"].as<int>();
+    return (DigitTransition::Style_e)std::max(
+        0, std::min(style, (int)DigitTransition::STYLE_TOTAL - 1));
 }
 
-void Clock::CheckIfWaitingToSaveSettings() {
-    if (m_shouldSaveSettings && m_waitingToSaveSettings.Ms() >= 2000) {
-        // wait until 2 seconds after changing the color to save
-        // settings, since the user can quickly change either one and we
-        // want to save flash write cycles
-
-        ElapsedTime saveTime;
-        m_settings->Save();
-        TDPRINT(m_rtc, "Saved settings in %dms                          \n",
-                saveTime.Ms());  // usually ~25ms
-        m_shouldSaveSettings = false;
-    }
+// wait until 2 seconds after changing the color to save settings, since the
+// user can quickly change either one and we want to save flash write cycles
+void Clock::PrepareToSaveSettings() {
+    m_timers->Start(m_saveTimer, SAVE_DELAY_MS);
 }
 
 void Clock::LoadSettings() {
@@ -213,6 +404,10 @@ void Clock::LoadSettings() {
         (*m_settings)["WLED"] = "ON";
     }
 
+    if (!(*m_settings).containsKey("DIGIT_FX")) {
+        (*m_settings)["DIGIT_FX"] = (int)DigitTransition::STYLE_MORPH;
+    }
+
     if (!(*m_settings).containsKey("ANIM")) {
         (*m_settings)["ANIM"] = m_animMode + 1;
     } else {
@@ -221,4 +416,9 @@ void Clock::LoadSettings() {
             m_animMode = ANIM_NORMAL;
         }
     }
+
+    // the profile only borrows the animation, ANIM stays as it was
+    if (m_profileAnimation > 0 && m_profileAnimation <= ANIM_TOTAL) {
+        m_animMode = m_profileAnimation - 1;
+    }
 }
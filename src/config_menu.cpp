@@ -115,6 +115,7 @@ void ConfigMenu::Add(const Item&& item) {
         item.display->m_pixels = m_pixels;
         item.display->m_settings = m_settings;
         item.display->m_rtc = m_rtc;
+        item.display->m_timers = m_timers;
         item.display->m_manager = m_manager;
         item.display->Initialize();
     }
@@ -174,4 +175,31 @@ void ConfigMenu::AddMenuItems() {
     // custom options
     std::reverse(m_items.begin(), m_items.end());
     m_selected = m_items.size() - 1;
+
+    Add({std::make_shared<Numeric>("PAL", 1, PALETTE_TOTAL), LED_UNUSED, WHITE,
+         [](Item& item) {
+             // shows off the selected palette
+             static uint8_t wheelPos = 0;
+             item.animFreq = 10;
+             item.color = Pixels::ColorWheel(wheelPos++);
+         }});
+
+    Add({std::make_shared<Numeric>("BG", 0, ANIM_TOTAL), LED_UNUSED, WHITE,
+         [](Item& item) {
+             static uint8_t wheelPos = 128;
+             item.animFreq = 10;
+             item.color = Pixels::ColorWheel(wheelPos--);
+         }});
+
+    Add({std::make_shared<Numeric>("WARM", 0, MAX_WARMTH), LED_UNUSED, WHITE,
+         [](Item& item) {
+             item.color = item.color == WHITE ? ORANGE : WHITE;
+             item.animFreq = 500;
+         }});
+
+    Add({std::make_shared<Numeric>("NITE", 0, 1), LED_UNUSED, DARK_BLUE,
+         [](Item& item) {
+             item.color = item.color == DARK_BLUE ? BLACK : DARK_BLUE;
+             item.animFreq = 1000;
+         }});
 }
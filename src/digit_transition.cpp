@@ -0,0 +1,158 @@
+#include <digit_transition.hpp>
+
+using Glyph = DigitGlyphs::Glyph;
+using Morph = DigitTransition::Morph;
+
+enum {
+    COLS = DigitGlyphs::COLS,
+    ROWS = DigitGlyphs::ROWS,
+    CELLS = DigitGlyphs::CELLS,
+    STEPS = DigitMorphs::STEPS,
+};
+
+///// compile time tables /////////////////////////////////////////////////////
+static constexpr DigitMorphs::Table MORPHS = DigitMorphs::BuildTable();
+static constexpr DigitMorphs::Ranks DISSOLVE_RANKS =
+    DigitMorphs::BuildDissolveRanks();
+
+///// DigitTransition /////////////////////////////////////////////////////////
+void DigitTransition::Start(const char from,
+                            const char to,
+                            const Style_e style) {
+    m_from = DigitGlyphs::Index(from);
+    m_to = DigitGlyphs::Index(to);
+    m_style = style;
+    m_elapsedMs = 0;
+    if (m_from < 0 || m_to < 0 || m_from == m_to) {
+        m_elapsedMs = DURATION_MS;
+    }
+}
+
+bool DigitTransition::IsActive() const {
+    return m_style != STYLE_NONE && m_elapsedMs < DURATION_MS;
+}
+
+void DigitTransition::Update(const size_t deltaMs) {
+    m_elapsedMs = std::min((size_t)DURATION_MS, m_elapsedMs + deltaMs);
+}
+
+template <typename Geometry>
+void DigitTransition::Draw(BasicPixels<Geometry>& pixels,
+                           const int x,
+                           const int y,
+                           const RgbColor beginColor,
+                           const RgbColor endColor) const {
+    switch (m_style) {
+        case STYLE_SLIDE:
+            DrawSlide(pixels, x, y, beginColor, endColor);
+            break;
+        case STYLE_DISSOLVE:
+            DrawDissolve(pixels, x, y, beginColor, endColor);
+            break;
+        case STYLE_MORPH:
+            DrawMorph(pixels, x, y, beginColor, endColor);
+            break;
+        default:
+            break;
+    }
+}
+
+const Morph& DigitTransition::GetMorph(const int from, const int to) {
+    return MORPHS[from][to];
+}
+
+uint8_t DigitTransition::GetProgress() const {
+    return (m_elapsedMs * PROGRESS_MAX) / DURATION_MS;
+}
+
+template <typename Geometry>
+void DigitTransition::DrawSlide(BasicPixels<Geometry>& pixels,
+                                const int x,
+                                const int y,
+                                const RgbColor beginColor,
+                                const RgbColor endColor) const {
+    // the two glyphs are stacked vertically and scrolled up by |offset| rows
+    const int offset = (GetProgress() * ROWS) / PROGRESS_MAX;
+    const Glyph& from = DigitGlyphs::GLYPHS[m_from];
+    const Glyph& to = DigitGlyphs::GLYPHS[m_to];
+    for (int cell = 0; cell < CELLS; ++cell) {
+        const int row = cell / COLS + offset;
+        const int col = cell % COLS;
+        const bool isLit = row < ROWS ? from[row * COLS + col]
+                                      : to[(row - ROWS) * COLS + col];
+        if (isLit) {
+            SetCell(pixels, x, y, cell,
+                    GetCellColor(beginColor, endColor, cell));
+        }
+    }
+}
+
+template <typename Geometry>
+void DigitTransition::DrawDissolve(BasicPixels<Geometry>& pixels,
+                                   const int x,
+                                   const int y,
+                                   const RgbColor beginColor,
+                                   const RgbColor endColor) const {
+    const int switched = (GetProgress() * CELLS) / PROGRESS_MAX;
+    const Glyph& from = DigitGlyphs::GLYPHS[m_from];
+    const Glyph& to = DigitGlyphs::GLYPHS[m_to];
+    for (int cell = 0; cell < CELLS; ++cell) {
+        const bool isLit =
+            DISSOLVE_RANKS[cell] < switched ? to[cell] : from[cell];
+        if (isLit) {
+            SetCell(pixels, x, y, cell,
+                    GetCellColor(beginColor, endColor, cell));
+        }
+    }
+}
+
+template <typename Geometry>
+void DigitTransition::DrawMorph(BasicPixels<Geometry>& pixels,
+                                const int x,
+                                const int y,
+                                const RgbColor beginColor,
+                                const RgbColor endColor) const {
+    const uint8_t progress = GetProgress();
+    const int step = (progress * STEPS + PROGRESS_MAX / 2) / PROGRESS_MAX;
+    const Morph& morph = MORPHS[m_from][m_to];
+
+    uint8_t fade = PROGRESS_MAX;
+    if (morph.fade == Morph::FADE_IN) {
+        fade = progress;
+    } else if (morph.fade == Morph::FADE_OUT) {
+        fade = PROGRESS_MAX - progress;
+    }
+
+    for (int i = 0; i < morph.numPaths; ++i) {
+        const int cell = morph.paths[i].cells[step];
+        const RgbColor color = GetCellColor(beginColor, endColor, cell);
+        SetCell(pixels, x, y, cell, RgbColor::LinearBlend(BLACK, color, fade));
+    }
+}
+
+RgbColor DigitTransition::GetCellColor(const RgbColor beginColor,
+                                       const RgbColor endColor,
+                                       const int cell) {
+    // approximates the per-pixel gradient that Pixels::DrawChar uses
+    return RgbColor::LinearBlend(beginColor, endColor,
+                                 (uint8_t)((cell * 255) / (CELLS - 1)));
+}
+
+template <typename Geometry>
+void DigitTransition::SetCell(BasicPixels<Geometry>& pixels,
+                              const int x,
+                              const int y,
+                              const int cell,
+                              const RgbColor color) {
+#if FCOS_CARDCLOCK || FCOS_CARDCLOCK2
+    pixels.Set(x + cell % COLS, y + cell / COLS, color);
+#elif FCOS_FOXIECLOCK
+    pixels.Set(x + cell, color);
+#endif
+}
+
+template void DigitTransition::Draw(Pixels& pixels,
+                                    const int x,
+                                    const int y,
+                                    const RgbColor beginColor,
+                                    const RgbColor endColor) const;
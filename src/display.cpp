@@ -3,9 +3,21 @@
 DisplayManager::DisplayManager(std::shared_ptr<Pixels> pixels,
                                std::shared_ptr<Settings> settings,
                                std::shared_ptr<Rtc> rtc,
-                               std::shared_ptr<Joystick> joy)
-    : m_pixels(pixels), m_settings(settings), m_rtc(rtc), m_joy(joy) {
+                               std::shared_ptr<Joystick> joy,
+                               std::shared_ptr<TimerWheel> timers)
+    : m_pixels(pixels),
+      m_settings(settings),
+      m_rtc(rtc),
+      m_joy(joy),
+      m_timers(timers) {
+    m_timeoutTimer = m_timers->Add([&]() { m_hasTimedOut = true; });
     ConfigureJoystick();
+    LoadProfiles();
+
+    if (!(*m_settings).containsKey("IDLE")) {
+        (*m_settings)["IDLE"] = 1;
+    }
+    m_isIdleEnabled = (*m_settings)["IDLE"].as<int>() != 0;
 }
 
 void DisplayManager::Add(std::shared_ptr<Display> display) {
@@ -14,6 +26,7 @@ void DisplayManager::Add(std::shared_ptr<Display> display) {
     m_displays.back()->m_pixels = m_pixels;
     m_displays.back()->m_settings = m_settings;
     m_displays.back()->m_rtc = m_rtc;
+    m_displays.back()->m_timers = m_timers;
     if (m_displays.back()->m_manager == nullptr) {
         m_displays.back()->m_manager = this;
         m_displays.back()->Initialize();
@@ -21,7 +34,19 @@ void DisplayManager::Add(std::shared_ptr<Display> display) {
 }
 
 void DisplayManager::Update() {
-    if (m_sinceLastUpdate.Ms() >= 1000 / FRAMES_PER_SECOND || m_isFirstUpdate) {
+    // the schedule knows when the next profile starts, so this is a compare
+    if (m_profiles.Update(m_rtc->LocalEpoch())) {
+        ApplyProfile(*m_profiles.Active());
+    }
+
+    if (m_rtc->Uptime() != m_lastTickUptime) {
+        m_lastTickUptime = m_rtc->Uptime();
+        m_idle.OnTick();
+    }
+
+    if ((m_sinceLastUpdate.Ms() >= GetFrameMs() && !IsIdle()) ||
+        m_isFirstUpdate) {
+        m_frameDeltaMs = m_isFirstUpdate ? 0 : m_sinceLastUpdate.Ms();
         m_sinceLastUpdate.Reset();
         if (m_isTempDisplay) {
             // Update the "parent" display of the temp display
@@ -32,9 +57,10 @@ void DisplayManager::Update() {
         }
 
         auto& cur = m_displays[m_activeDisplay];
+        m_pixels->GetFrameStats().SetBucket(cur->m_name.c_str());
         cur->Update();
         if (cur->IsDone() ||
-            (cur->ShouldTimeout() && GetTimeSinceButtonPress() >= TIMEOUT_MS &&
+            (cur->ShouldTimeout() && m_hasTimedOut &&
              m_activeDisplay != m_defaultDisplay)) {
             cur->Timeout();
             cur->m_done = false;
@@ -45,11 +71,23 @@ void DisplayManager::Update() {
             }
         }
 
+        m_pixels->SetTimeOfDay(m_rtc->Hour(), m_rtc->Minute());
         m_pixels->Update();
+        m_idle.OnFrame(m_pixels->GetLastFrameChanged(),
+                       m_pixels->GetBrightness() * BRIGHTNESS_BUCKETS);
         m_isFirstUpdate = false;
     }
 }
 
+// only the default display (Clock) is left waiting, menus draw every frame.
+// The display has to say that it's static as well, the IdleDetector only
+// backs that up with what the LEDs did
+bool DisplayManager::IsIdle() {
+    return m_isIdleEnabled && m_activeDisplay == m_defaultDisplay &&
+           !m_isTempDisplay && m_idle.CanSkipFrame() &&
+           m_displays[m_activeDisplay]->IsStaticUntilNextTick();
+}
+
 std::shared_ptr<Display> DisplayManager::GetActive() {
     return m_displays[m_activeDisplay];
 }
@@ -61,10 +99,13 @@ void DisplayManager::SetDefaultAndActivateDisplay(const size_t displayNum) {
 
 void DisplayManager::ActivateDisplay(const size_t displayNum) {
     if (displayNum < m_displays.size()) {
+        if (m_activeDisplay != displayNum && m_isTempDisplay) {
+            LoadProfiles();  // leaving ConfigMenu, where NITE may have changed
+        }
         m_displays[m_activeDisplay]->Hide();
         m_activeDisplay = displayNum;
         m_displays[m_activeDisplay]->Activate();
-        ResetTimeSinceButtonPress();
+        RestartTimeout();
 
         if (m_isTempDisplay && m_activeDisplay != m_displays.size() - 1) {
             m_displays.pop_back();
@@ -88,17 +129,17 @@ void DisplayManager::ConfigureJoystick() {
 
     m_joy->press.config.handlerFunc = [&](const Button::Event_e evt) {
         m_displays[m_activeDisplay]->Press(evt);
-        ResetTimeSinceButtonPress();
+        RestartTimeout();
     };
 
     m_joy->up.config.handlerFunc = [&](const Button::Event_e evt) {
         m_displays[m_activeDisplay]->Up(evt);
-        ResetTimeSinceButtonPress();
+        RestartTimeout();
     };
 
     m_joy->down.config.handlerFunc = [&](const Button::Event_e evt) {
         m_displays[m_activeDisplay]->Down(evt);
-        ResetTimeSinceButtonPress();
+        RestartTimeout();
     };
 
     m_joy->left.config.handlerFunc = [&](const Button::Event_e evt) {
@@ -109,7 +150,7 @@ void DisplayManager::ConfigureJoystick() {
             }
             ActivateDisplay(m_activeDisplay - 1);
         }
-        ResetTimeSinceButtonPress();
+        RestartTimeout();
     };
 
     m_joy->right.config.handlerFunc = [&](const Button::Event_e evt) {
@@ -120,13 +161,80 @@ void DisplayManager::ConfigureJoystick() {
             }
             ActivateDisplay(m_activeDisplay + 1);
         }
-        ResetTimeSinceButtonPress();
+        RestartTimeout();
+    };
+}
+
+void DisplayManager::RestartTimeout() {
+    m_hasTimedOut = false;
+    m_timers->Start(m_timeoutTimer, TIMEOUT_MS);
+    m_idle.OnInput();
+}
+
+// NITE turns on a second profile for the night, from NITE_FROM to NITE_TO
+// (HHMM), with its own frame rate, brightness ceiling, animation, WiFi
+// power saving and CPU frequency (which bit-banged LEDs can't follow)
+void DisplayManager::LoadProfiles() {
+    const PowerProfile night{
+        5, 2, 0, true, Pixels::IS_CPU_TIMED ? CPU_MHZ_DEFAULT : 80};
+    const std::pair<const char*, int> defaults[] = {
+        {"NITE", 0},
+        {"NITE_FROM", 2200},
+        {"NITE_TO", 700},
+        {"NITE_FPS", night.fps},
+        {"NITE_MAXB", night.maxBrightness},
+        {"NITE_ANIM", night.animation},
+        {"NITE_WIFIPS", night.wifiPowerSave},
+        {"NITE_MHZ", night.cpuMhz},
+    };
+    for (const auto& setting : defaults) {
+        if (!(*m_settings).containsKey(setting.first)) {
+            (*m_settings)[setting.first] = setting.second;
+        }
+    }
+
+    m_profiles.Clear();
+    if ((*m_settings)["NITE"].as<int>() == 0) {
+        ApplyProfile(PowerProfile());
+        return;
+    }
+    auto toMinutes = [](const int hhmm) {
+        return (hhmm / 100) * 60 + hhmm % 100;
     };
+    m_profiles.Add(toMinutes((*m_settings)["NITE_TO"].as<int>()),
+                   PowerProfile());
+    m_profiles.Add(
+        toMinutes((*m_settings)["NITE_FROM"].as<int>()),
+        {(uint8_t)std::max(1, (*m_settings)["NITE_FPS"].as<int>()),
+         (*m_settings)["NITE_MAXB"].as<uint8_t>(),
+         (*m_settings)["NITE_ANIM"].as<uint8_t>(),
+         (*m_settings)["NITE_WIFIPS"].as<int>() != 0,
+         (*m_settings)["NITE_MHZ"].as<uint16_t>()});
 }
 
-void DisplayManager::ResetTimeSinceButtonPress() {
-    m_timeSinceButtonPress.Reset();
+void DisplayManager::ApplyProfile(const PowerProfile& profile) {
+    if (profile == m_profile && !m_isFirstUpdate) {
+        return;
+    }
+    m_profile = profile;
+    m_pixels->SetMaxBrightness(profile.maxBrightness);
+    for (auto& display : m_displays) {
+        display->ApplyProfile(profile);
+    }
+    const int cpuMhz = profile.cpuMhz && !Pixels::IS_CPU_TIMED
+                           ? profile.cpuMhz
+                           : CPU_MHZ_DEFAULT;
+#if FCOS_ESP32_C3
+    WiFi.setSleep(profile.wifiPowerSave ? WIFI_PS_MAX_MODEM : WIFI_PS_MIN_MODEM);
+    setCpuFrequencyMhz(cpuMhz);
+#endif
+    DPRINT("Power profile: %d FPS, MAXB %d, ANIM %d, WiFi PS %d, %dMHz\n",
+           profile.fps, profile.maxBrightness, profile.animation,
+           profile.wifiPowerSave, cpuMhz);
 }
-size_t DisplayManager::GetTimeSinceButtonPress() {
-    return m_timeSinceButtonPress.Ms();
+
+// the profile's frame rate is for the clock; menus stay responsive
+size_t DisplayManager::GetFrameMs() {
+    const bool isClock = m_activeDisplay == m_defaultDisplay && !m_isTempDisplay;
+    return 1000 / (isClock ? m_profile.fps : FRAMES_PER_SECOND);
 }
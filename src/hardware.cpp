@@ -1,31 +1,220 @@
+#include <algorithm>
+
+#include <coroutine.hpp>
 #include <hardware.hpp>
 #include <light_sensor.hpp>
+#include <loop_stats.hpp>
+#if FCOS_ESP32_C3
+#include <driver/gpio.h>
+#include <esp_sleep.h>
+#endif
 
-static void HardwareTest_CardClock2(std::shared_ptr<Pixels> pixels,
-                                    std::shared_ptr<Settings> settings,
-                                    std::shared_ptr<Rtc> rtc,
-                                    std::shared_ptr<Joystick> joy);
-
-static void HardwareTest_FoxieClock2(std::shared_ptr<Pixels> pixels,
-                                     std::shared_ptr<Settings> settings,
-                                     std::shared_ptr<Rtc> rtc,
-                                     std::shared_ptr<Joystick> joy);
-
-void ShowSerialStatusMessage(std::shared_ptr<Pixels> pixels,
-                             std::shared_ptr<Rtc> rtc) {
-    static ElapsedTime statusDisplayTimer;
-    if (statusDisplayTimer.Ms() >= 50) {
-        statusDisplayTimer.Reset();
-        TDPRINT(rtc, "Light Sensor:%.1f%% - Uptime:%ds - WiFi:%d \r",
-                pixels->GetBrightness() * 100, rtc->Uptime(),
-                WiFi.isConnected());
-    }
+enum {
+    // how long before an RTC tick to stop waiting, so that the interrupt
+    // timestamps the edge itself rather than a wakeup does
+    WAKE_BEFORE_TICK_US = 5000,
+    TICK_LATE_MS = 20,  // waiting any longer, the tick is missing
+    STATUS_MESSAGE_MS = 1000,
+    STATS_MS = 10000,
+};
+
+static const int BUTTON_PINS[] = {PIN_BTN_UP, PIN_BTN_DOWN, PIN_BTN_LEFT,
+                                  PIN_BTN_RIGHT, PIN_BTN_PRESS};
+
+static LoopStats s_loopStats;
+
+// The startup flows wait on the buttons, so they're coroutines that the
+// loop in setup() resumes once a frame (see coroutine.hpp)
+class HardwareTest : public Coroutine {
+  public:
+    HardwareTest(std::shared_ptr<Pixels> pixels,
+                 std::shared_ptr<Settings> settings,
+                 std::shared_ptr<Rtc> rtc,
+                 std::shared_ptr<Joystick> joy)
+        : m_pixels(pixels), m_settings(settings), m_rtc(rtc), m_joy(joy) {}
+
+  protected:
+    std::shared_ptr<Pixels> m_pixels;
+    std::shared_ptr<Settings> m_settings;
+    std::shared_ptr<Rtc> m_rtc;
+    std::shared_ptr<Joystick> m_joy;
+    size_t m_beginUptime{0};
+    bool m_foundLightSensorMin{false};
+
+    void CalibrateLightSensorMin();
+};
+
+class HardwareTest_CardClock2 : public HardwareTest {
+  public:
+    using HardwareTest::HardwareTest;
+
+  protected:
+    virtual void Run() override;
+};
+
+class HardwareTest_FoxieClock2 : public HardwareTest {
+  public:
+    using HardwareTest::HardwareTest;
+
+  protected:
+    virtual void Run() override;
+};
+
+// clears the settings and restarts, once the button is let go
+class FactoryReset : public HardwareTest {
+  public:
+    using HardwareTest::HardwareTest;
+
+  protected:
+    virtual void Run() override;
+};
+
+static void CalibrateLEDs(std::shared_ptr<Pixels> pixels,
+                          std::shared_ptr<Joystick> joy);
+
+static void ShowSerialStatusMessage(std::shared_ptr<Pixels> pixels,
+                                    std::shared_ptr<Rtc> rtc) {
+    TDPRINT(rtc,
+            "Light Sensor:%.1f%% - Uptime:%ds - WiFi:%d - LEDs:%dmA "
+            "(limited %d times) \r",
+            pixels->GetBrightness() * 100, rtc->Uptime(), WiFi.isConnected(),
+            pixels->GetEstimatedCurrentMa(), pixels->GetPowerClampCount());
 }
 
-void DoHardwareStartupTests(std::shared_ptr<Pixels> pixels,
+// what each Display/Animator has been doing to the LEDs, how much the RTC
+// has been using the I2C bus, and how busy the loop has been. Only while the
+// STATS setting is 1, as the frame stats cost a pass over every frame.
+static void ShowSerialStats(std::shared_ptr<Pixels> pixels,
                             std::shared_ptr<Settings> settings,
-                            std::shared_ptr<Rtc> rtc,
-                            std::shared_ptr<Joystick> joy) {
+                            std::shared_ptr<Rtc> rtc) {
+    const bool isEnabled = ((*settings)["STATS"] == "1");
+    if (!pixels->GetFrameStats().IsEnabled()) {
+        pixels->GetFrameStats().SetEnabled(isEnabled);
+        return;  // nothing has been counted yet
+    }
+    pixels->GetFrameStats().SetEnabled(isEnabled);
+
+    DPRINT("\n%s", pixels->GetFrameStats().Report().c_str());
+    pixels->GetFrameStats().Reset();
+
+    const auto& i2c = rtc->GetI2cStats();
+    DPRINT("RTC I2C: %u reads (%u failed), avg %uus, max %uus\n",
+           i2c.reads, i2c.failures,
+           i2c.reads ? (uint32_t)(i2c.totalUs / i2c.reads) : 0,
+           i2c.maxUs);
+    const auto& ticks = rtc->GetTickStats();
+    DPRINT("RTC ticks: %u coalesced (longest stall %us), %u missed\n",
+           ticks.coalesced, ticks.maxPending, ticks.missed);
+    const auto& discipline = rtc->GetClockDiscipline();
+    DPRINT("RTC drift: %.1fppm after %u NTP syncs, next in ~%dm\n",
+           discipline.GetDriftPpm(), discipline.GetSyncs(),
+           discipline.GetIntervalS() / 60);
+    DPRINT("Loop: %.1f/s, CPU busy %.1f%%\n",
+           s_loopStats.GetIterationsPerSecond(),
+           s_loopStats.GetBusyPercent());
+    s_loopStats.Reset();
+}
+
+void StartSerialStatus(std::shared_ptr<TimerWheel> timers,
+                       std::shared_ptr<Pixels> pixels,
+                       std::shared_ptr<Settings> settings,
+                       std::shared_ptr<Rtc> rtc) {
+    if (!(*settings).containsKey("STATS")) {
+        (*settings)["STATS"] = "0";
+    }
+    timers->Every(STATUS_MESSAGE_MS,
+                  [=]() { ShowSerialStatusMessage(pixels, rtc); });
+    timers->Every(STATS_MS, [=]() { ShowSerialStats(pixels, settings, rtc); });
+}
+
+static bool IsAnyButtonDown() {
+    for (const int pin : BUTTON_PINS) {
+        if (digitalRead(pin) == LOW) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Until the next RTC tick, a button press or |maxWaitMs| (the next timer).
+// With WiFi turned off, the CPU light sleeps until just before the tick,
+// woken by a timer (so the RTC interrupt still timestamps the edge itself)
+// or a button's GPIO. Otherwise, and for the last few ms, it blocks on the
+// tick and button events, so the CPU idles in the scheduler while WiFi stays
+// in modem sleep.
+// Returns how long it waited.
+static uint32_t WaitUntilNextTick(std::shared_ptr<Rtc> rtc,
+                                  std::shared_ptr<Settings> settings,
+                                  const uint32_t maxWaitMs) {
+    const uint32_t beginUs = micros();
+    const uint32_t untilTickUs = rtc->MicrosUntilNextTick();
+    if (untilTickUs == 0 || maxWaitMs == 0 || rtc->IsTickPending() ||
+        IsAnyButtonDown()) {
+        yield();
+        return 0;
+    }
+
+#if FCOS_ESP32_C3
+    // not just while disconnected, as WiFi can't associate or reconnect
+    // after the AP drops (and SNTP never runs) while the CPU sleeps
+    const bool isWiFiOff =
+        (*settings)["WIFI"] == "0" || WiFi.getMode() == WIFI_OFF;
+    if (isWiFiOff && untilTickUs > WAKE_BEFORE_TICK_US) {
+        for (const int pin : BUTTON_PINS) {
+            gpio_wakeup_enable((gpio_num_t)pin, GPIO_INTR_LOW_LEVEL);
+        }
+        esp_sleep_enable_gpio_wakeup();
+        esp_sleep_enable_timer_wakeup(
+            std::min<uint64_t>(untilTickUs - WAKE_BEFORE_TICK_US,
+                               (uint64_t)maxWaitMs * 1000));
+        esp_light_sleep_start();
+        for (const int pin : BUTTON_PINS) {
+            gpio_wakeup_disable((gpio_num_t)pin);
+            // back to the Joystick's interrupt, which wakeups replace
+            gpio_set_intr_type((gpio_num_t)pin, GPIO_INTR_ANYEDGE);
+        }
+        return micros() - beginUs;
+    }
+#endif
+
+    // waits for the ISR's tick counter to move, as the event bit may be left
+    // over from a tick that rtc->Update() already drained, and clearing it
+    // first would lose a tick that fired since then
+    const uint32_t waitMs =
+        std::min<uint32_t>(untilTickUs / 1000 + TICK_LATE_MS, maxWaitMs);
+    while (!rtc->IsTickPending()) {
+        const uint32_t waitedMs = (micros() - beginUs) / 1000;
+        if (waitedMs >= waitMs ||
+            (LoopEvents().Wait(EVENT_RTC_TICK | EVENT_BUTTON,
+                               waitMs - waitedMs) &
+             EVENT_BUTTON)) {
+            break;
+        }
+    }
+    return micros() - beginUs;
+}
+
+void WaitForNextEvent(std::shared_ptr<Rtc> rtc,
+                      std::shared_ptr<Settings> settings,
+                      std::shared_ptr<TimerWheel> timers,
+                      const bool isIdle) {
+    static uint32_t lastUs = micros();
+    uint32_t waitUs = 0;
+    if (isIdle) {
+        waitUs = WaitUntilNextTick(rtc, settings, timers->MsUntilNext());
+    } else {
+        yield();  // allow the ESP platform tasks to run
+    }
+    const uint32_t nowUs = micros();
+    s_loopStats.AddIteration(nowUs - lastUs - waitUs, waitUs);
+    lastUs = nowUs;
+}
+
+std::shared_ptr<Coroutine> DoHardwareStartupTests(
+    std::shared_ptr<Pixels> pixels,
+    std::shared_ptr<Settings> settings,
+    std::shared_ptr<Rtc> rtc,
+    std::shared_ptr<Joystick> joy) {
 #if FCOS_ESP32_C3
     Serial.begin();
 #elif FCOS_ESP8266
@@ -41,180 +230,273 @@ void DoHardwareStartupTests(std::shared_ptr<Pixels> pixels,
     if (joy->AreAnyButtonsPressed() == PIN_BTN_UP ||
         (*settings)["TEST"].as<int>() == 0) {
 #if FCOS_CARDCLOCK2
-        HardwareTest_CardClock2(pixels, settings, rtc, joy);
+        return std::make_shared<HardwareTest_CardClock2>(pixels, settings, rtc,
+                                                         joy);
 #elif FCOS_FOXIECLOCK
-        HardwareTest_FoxieClock2(pixels, settings, rtc, joy);
+        return std::make_shared<HardwareTest_FoxieClock2>(pixels, settings,
+                                                          rtc, joy);
 #endif
+    } else if (joy->AreAnyButtonsPressed() == PIN_BTN_DOWN) {
+        CalibrateLEDs(pixels, joy);
     } else if (joy->AreAnyButtonsPressed() == PIN_BTN_LEFT) {
-        // clear settings and restart
-        pixels->Clear();
-        pixels->DrawChar(8, ':', ORANGE);
-        pixels->Show();
-        joy->WaitForNoButtonsPressed();
-        settings->clear();
-        settings->Save();
-        rtc->SetClockToZero();
-        WiFi.disconnect(true, true);
-        ElapsedTime::Delay(50);
-        ESP.restart();
+        return std::make_shared<FactoryReset>(pixels, settings, rtc, joy);
     }
+    return nullptr;
 }
 
-void HardwareTest_CardClock2(std::shared_ptr<Pixels> pixels,
-                             std::shared_ptr<Settings> settings,
-                             std::shared_ptr<Rtc> rtc,
-                             std::shared_ptr<Joystick> joy) {
-    auto beginUptime = rtc->Uptime();
-    pixels->DrawChar(0, 3, CHAR_UP_ARROW, ORANGE);
-    pixels->Show();
-    joy->WaitForNoButtonsPressed();
-    joy->WaitForButton(joy->up);
-    pixels->DrawChar(0, 3, CHAR_UP_ARROW, GREEN);
-
-    pixels->DrawChar(4, 3, CHAR_DOWN_ARROW, ORANGE);
-    pixels->Show();
-    joy->WaitForButton(joy->down);
-    pixels->DrawChar(4, 3, CHAR_DOWN_ARROW, GREEN);
-
-    pixels->DrawChar(8, 3, CHAR_RIGHT_ARROW, ORANGE);
-    pixels->Show();
-    joy->WaitForButton(joy->right);
-    pixels->DrawChar(8, 3, CHAR_RIGHT_ARROW, GREEN);
-
-    pixels->DrawChar(12, 3, CHAR_LEFT_ARROW, ORANGE);
-    pixels->Show();
-    joy->WaitForButton(joy->left);
-    pixels->DrawChar(12, 3, CHAR_LEFT_ARROW, GREEN);
-
-    pixels->Clear();
-    pixels->DrawText(0, 3, "PRES", ORANGE);
-    pixels->Show();
-    joy->WaitForButton(joy->press);
-
-    joy->WaitForNoButtonsPressed();
-    for (int i = 0; i < TOTAL_ALL_LEDS; ++i) {
-        pixels->Set(i, Pixels::ColorWheel(i));
-    }
-    pixels->Show();
-    joy->WaitForButton(joy->press);
+void FactoryReset::Run() {
+    CO_BEGIN();
+    m_pixels->Clear();
+    m_pixels->DrawChar(8, ':', ORANGE);
+    m_pixels->Show();
+    CO_AWAIT(m_joy->AreAnyButtonsPressed() == -1);
+    m_settings->clear();
+    m_settings->Save();
+    m_rtc->SetClockToZero();
+    WiFi.disconnect(true, true);
+    CO_DELAY(50);
+    ESP.restart();
+    CO_END();
+}
 
-    pixels->Clear();
-    pixels->Show();
-    ElapsedTime::Delay(50);
+// with the LEDs off, the lowest reading that still scales to dark
+void HardwareTest::CalibrateLightSensorMin() {
     LightSensor ls;
     ls.SetHwMax(LightSensor::HW_MAX);
 
-    bool found = false;
+    m_foundLightSensorMin = false;
     for (size_t i = 0; i <= 10; ++i) {
         ls.SetHwMin(LightSensor::HW_MIN + i);
         ls.ResetToCurrentSensorValue();
         if (ls.GetScaled() < 0.001f) {
-            found = true;
+            m_foundLightSensorMin = true;
             DPRINT("Found min:%d\n", LightSensor::HW_MIN + i);
             break;
         }
     }
-    if (!found) {
-        pixels->Clear();
-        pixels->DrawText(0, 3, "ERR1", PURPLE);
-        pixels->Show();
-        joy->WaitForButton(joy->press);
-    } else {
-        (*settings)["LS_HW_MIN"] = ls.GetHwMin();
-        (*settings)["LS_HW_MAX"] = ls.GetHwMax();
+    if (m_foundLightSensorMin) {
+        (*m_settings)["LS_HW_MIN"] = ls.GetHwMin();
+        (*m_settings)["LS_HW_MAX"] = ls.GetHwMax();
         DPRINT("LS_HW_MIN: %d\n", ls.GetHwMin());
     }
+}
 
-    pixels->Clear();
-    if (rtc->Uptime() != beginUptime) {
-        pixels->DrawText(0, 3, "ERR2", RED);
-        pixels->Show();
+void HardwareTest_CardClock2::Run() {
+    CO_BEGIN();
+    m_beginUptime = m_rtc->Uptime();
+    m_pixels->DrawChar(0, 3, CHAR_UP_ARROW, ORANGE);
+    m_pixels->Show();
+    CO_AWAIT(m_joy->AreAnyButtonsPressed() == -1);
+    CO_AWAIT(m_joy->up.IsPressed());
+    m_pixels->DrawChar(0, 3, CHAR_UP_ARROW, GREEN);
+
+    m_pixels->DrawChar(4, 3, CHAR_DOWN_ARROW, ORANGE);
+    m_pixels->Show();
+    CO_AWAIT(m_joy->down.IsPressed());
+    m_pixels->DrawChar(4, 3, CHAR_DOWN_ARROW, GREEN);
+
+    m_pixels->DrawChar(8, 3, CHAR_RIGHT_ARROW, ORANGE);
+    m_pixels->Show();
+    CO_AWAIT(m_joy->right.IsPressed());
+    m_pixels->DrawChar(8, 3, CHAR_RIGHT_ARROW, GREEN);
+
+    m_pixels->DrawChar(12, 3, CHAR_LEFT_ARROW, ORANGE);
+    m_pixels->Show();
+    CO_AWAIT(m_joy->left.IsPressed());
+    m_pixels->DrawChar(12, 3, CHAR_LEFT_ARROW, GREEN);
+
+    m_pixels->Clear();
+    m_pixels->DrawText(0, 3, "PRES", ORANGE);
+    m_pixels->Show();
+    CO_AWAIT(m_joy->press.IsPressed());
+
+    CO_AWAIT(m_joy->AreAnyButtonsPressed() == -1);
+    for (int i = 0; i < Pixels::Shape::TOTAL_LEDS; ++i) {
+        m_pixels->Set(i, Pixels::ColorWheel(i));
+    }
+    m_pixels->Show();
+    CO_AWAIT(m_joy->press.IsPressed());
+
+    m_pixels->Clear();
+    m_pixels->Show();
+    CO_DELAY(50);
+    CalibrateLightSensorMin();
+    if (!m_foundLightSensorMin) {
+        m_pixels->Clear();
+        m_pixels->DrawText(0, 3, "ERR1", PURPLE);
+        m_pixels->Show();
+        CO_AWAIT(m_joy->press.IsPressed());
+    }
+
+    // the RTC is updated while the test waits, so a working one has ticked
+    m_pixels->Clear();
+    if (m_rtc->Uptime() == m_beginUptime) {
+        m_pixels->DrawText(0, 3, "ERR2", RED);
+        m_pixels->Show();
     } else {
-        pixels->DrawText(1, 3, " OK ", GREEN);  // everything and RTC is good
-        pixels->Show();
-        (*settings)["TEST"] = 1;  // test success
-        (*settings).Save();
-        joy->WaitForNoButtonsPressed();
+        m_pixels->DrawText(1, 3, " OK ", GREEN);  // everything and RTC is good
+        m_pixels->Show();
+        (*m_settings)["TEST"] = 1;  // test success
+        (*m_settings).Save();
+        CO_AWAIT(m_joy->AreAnyButtonsPressed() == -1);
     }
-    ElapsedTime::Delay(1000);
+    CO_DELAY(1000);
+    CO_END();
 }
 
-void HardwareTest_FoxieClock2(std::shared_ptr<Pixels> pixels,
-                              std::shared_ptr<Settings> settings,
-                              std::shared_ptr<Rtc> rtc,
-                              std::shared_ptr<Joystick> joy) {
-    auto beginUptime = rtc->Uptime();
-    pixels->DrawChar(0, 3, CHAR_UP_ARROW, ORANGE);
-    pixels->Show();
-    joy->WaitForNoButtonsPressed();
-    joy->WaitForButton(joy->up);
-    pixels->DrawChar(0, 0, CHAR_UP_ARROW, GREEN);
+void HardwareTest_FoxieClock2::Run() {
+    CO_BEGIN();
+    m_beginUptime = m_rtc->Uptime();
+    m_pixels->DrawChar(0, 3, CHAR_UP_ARROW, ORANGE);
+    m_pixels->Show();
+    CO_AWAIT(m_joy->AreAnyButtonsPressed() == -1);
+    CO_AWAIT(m_joy->up.IsPressed());
+    m_pixels->DrawChar(0, 0, CHAR_UP_ARROW, GREEN);
 
-    pixels->DrawChar(0, 0, CHAR_DOWN_ARROW, ORANGE);
-    pixels->Show();
-    joy->WaitForButton(joy->down);
-    pixels->DrawChar(0, 0, CHAR_DOWN_ARROW, GREEN);
+    m_pixels->DrawChar(0, 0, CHAR_DOWN_ARROW, ORANGE);
+    m_pixels->Show();
+    CO_AWAIT(m_joy->down.IsPressed());
+    m_pixels->DrawChar(0, 0, CHAR_DOWN_ARROW, GREEN);
 
-    pixels->DrawChar(62, 0, '?', ORANGE);
-    pixels->Show();
-    joy->WaitForButton(joy->right);
-    pixels->DrawChar(62, 0, '?', GREEN);
+    m_pixels->DrawChar(62, 0, '?', ORANGE);
+    m_pixels->Show();
+    CO_AWAIT(m_joy->right.IsPressed());
+    m_pixels->DrawChar(62, 0, '?', GREEN);
 
-    pixels->DrawChar(0, 0, '?', ORANGE);
-    pixels->Show();
-    joy->WaitForButton(joy->left);
-    pixels->DrawChar(0, 0, '?', GREEN);
+    m_pixels->DrawChar(0, 0, '?', ORANGE);
+    m_pixels->Show();
+    CO_AWAIT(m_joy->left.IsPressed());
+    m_pixels->DrawChar(0, 0, '?', GREEN);
 
-    pixels->Clear();
-    pixels->DrawChar(20, 0, '?', ORANGE);
-    pixels->DrawChar(42, 0, '?', ORANGE);
-    pixels->Show();
-    joy->WaitForButton(joy->press);
+    m_pixels->Clear();
+    m_pixels->DrawChar(20, 0, '?', ORANGE);
+    m_pixels->DrawChar(42, 0, '?', ORANGE);
+    m_pixels->Show();
+    CO_AWAIT(m_joy->press.IsPressed());
 
-    joy->WaitForNoButtonsPressed();
-    for (int i = 0; i < TOTAL_ALL_LEDS; ++i) {
-        pixels->Set(i, Pixels::ColorWheel(i));
+    CO_AWAIT(m_joy->AreAnyButtonsPressed() == -1);
+    for (int i = 0; i < Pixels::Shape::TOTAL_LEDS; ++i) {
+        m_pixels->Set(i, Pixels::ColorWheel(i));
     }
-    pixels->Show();
-    joy->WaitForButton(joy->press);
+    m_pixels->Show();
+    CO_AWAIT(m_joy->press.IsPressed());
 
-    pixels->Clear();
-    pixels->Show();
-    ElapsedTime::Delay(50);
-    LightSensor ls;
-    ls.SetHwMax(LightSensor::HW_MAX);
-
-    bool found = false;
-    for (size_t i = 0; i <= 10; ++i) {
-        ls.SetHwMin(LightSensor::HW_MIN + i);
-        ls.ResetToCurrentSensorValue();
-        if (ls.GetScaled() < 0.001f) {
-            found = true;
-            DPRINT("Found min:%d\n", LightSensor::HW_MIN + i);
-            break;
-        }
+    m_pixels->Clear();
+    m_pixels->Show();
+    CO_DELAY(50);
+    CalibrateLightSensorMin();
+    if (!m_foundLightSensorMin) {
+        m_pixels->Clear();
+        m_pixels->DrawText(0, 0, "ERR1", PURPLE);
+        m_pixels->Show();
+        CO_AWAIT(m_joy->press.IsPressed());
     }
-    if (!found) {
-        pixels->Clear();
-        pixels->DrawText(0, 0, "ERR1", PURPLE);
-        pixels->Show();
-        joy->WaitForButton(joy->press);
+
+    // the RTC is updated while the test waits, so a working one has ticked
+    m_pixels->Clear();
+    if (m_rtc->Uptime() == m_beginUptime) {
+        m_pixels->DrawText(0, 0, "????", RED);
+        m_pixels->Show();
     } else {
-        (*settings)["LS_HW_MIN"] = ls.GetHwMin();
-        (*settings)["LS_HW_MAX"] = ls.GetHwMax();
-        DPRINT("LS_HW_MIN: %d\n", ls.GetHwMin());
+        m_pixels->DrawText(0, 0, "11:11", GREEN);  // everything and RTC is good
+        m_pixels->Show();
+        (*m_settings)["TEST"] = 1;  // test success
+        (*m_settings).Save();
+        CO_AWAIT(m_joy->AreAnyButtonsPressed() == -1);
     }
+    CO_DELAY(1000);
+    CO_END();
+}
 
-    pixels->Clear();
-    if (rtc->Uptime() != beginUptime) {
-        pixels->DrawText(0, 0, "????", RED);
-        pixels->Show();
-    } else {
-        pixels->DrawText(0, 0, "11:11", GREEN);  // everything and RTC is good
-        pixels->Show();
-        (*settings)["TEST"] = 1;  // test success
-        (*settings).Save();
-        joy->WaitForNoButtonsPressed();
+// Left/Right pick an LED, which blinks in the color of the channel being
+// adjusted, Up/Down change that channel's gain, a press switches between
+// all channels, red, green and blue, and a long press saves and exits.
+void CalibrateLEDs(std::shared_ptr<Pixels> pixels,
+                   std::shared_ptr<Joystick> joy) {
+    enum {
+        GAIN_STEP = 2,
+        BLINK_MS = 250,
+    };
+    enum Channel_e { CHANNEL_ALL, CHANNEL_R, CHANNEL_G, CHANNEL_B, NUM_CHANNELS };
+    static const RgbColor CHANNEL_COLORS[NUM_CHANNELS] = {WHITE, RED, GREEN,
+                                                          BLUE};
+
+    int selected = 0;
+    int channel = CHANNEL_ALL;
+    bool done = false;
+
+    auto adjust = [&](const int delta) {
+        Pixels::Calibration cal = pixels->GetCalibration(selected);
+        auto step = [&](uint8_t& gain) {
+            gain = std::max(0, std::min(gain + delta, 255));
+        };
+        if (channel == CHANNEL_ALL || channel == CHANNEL_R) {
+            step(cal.r);
+        }
+        if (channel == CHANNEL_ALL || channel == CHANNEL_G) {
+            step(cal.g);
+        }
+        if (channel == CHANNEL_ALL || channel == CHANNEL_B) {
+            step(cal.b);
+        }
+        pixels->SetCalibration(selected, cal);
+    };
+    auto select = [&](const int delta) {
+        selected = (selected + delta + Pixels::Shape::TOTAL_LEDS) %
+                   Pixels::Shape::TOTAL_LEDS;
+    };
+
+    joy->up.config.handlerFunc = [&](const Button::Event_e evt) {
+        if (evt == Button::PRESS || evt == Button::REPEAT) {
+            adjust(GAIN_STEP);
+        }
+    };
+    joy->down.config.handlerFunc = [&](const Button::Event_e evt) {
+        if (evt == Button::PRESS || evt == Button::REPEAT) {
+            adjust(-GAIN_STEP);
+        }
+    };
+    joy->left.config.handlerFunc = [&](const Button::Event_e evt) {
+        if (evt == Button::PRESS || evt == Button::REPEAT) {
+            select(-1);
+        }
+    };
+    joy->right.config.handlerFunc = [&](const Button::Event_e evt) {
+        if (evt == Button::PRESS || evt == Button::REPEAT) {
+            select(1);
+        }
+    };
+    joy->press.config.handlerFunc = [&](const Button::Event_e evt) {
+        if (evt == Button::PRESS) {
+            channel = (channel + 1) % NUM_CHANNELS;
+        } else if (evt == Button::LONG_PRESS) {
+            done = true;
+        }
+    };
+
+    joy->WaitForNoButtonsPressed();
+    ElapsedTime blink;
+    while (!done) {
+        joy->Update();
+        // every LED shows the same gray, so any that doesn't match its
+        // neighbours needs adjusting
+        for (int i = 0; i < Pixels::Shape::TOTAL_LEDS; ++i) {
+            pixels->Set(i, GRAY);
+        }
+        if ((blink.Ms() / BLINK_MS) % 2) {
+            pixels->Set(selected, CHANNEL_COLORS[channel]);
+        }
+        pixels->Update();
+        // nothing changes until a button does, or the blink
+        joy->WaitForInput(BLINK_MS - blink.Ms() % BLINK_MS);
+    }
+
+    pixels->SaveCalibration();
+    for (Button* btn : {&joy->up, &joy->down, &joy->left, &joy->right,
+                        &joy->press}) {
+        btn->config.handlerFunc = nullptr;
     }
-    ElapsedTime::Delay(1000);
+    pixels->Clear();
+    pixels->Show();
+    joy->WaitForNoButtonsPressed();
 }
@@ -10,6 +10,7 @@
 #include <pixels.hpp>
 #include <rtc.hpp>
 #include <settings.hpp>
+#include <timer_wheel.hpp>
 
 void setup() {
     auto settings = std::make_shared<Settings>();
@@ -17,14 +18,24 @@ void setup() {
     auto rtc = std::make_shared<Rtc>(settings);
     auto joy = std::make_shared<Joystick>();
     auto develUpdates = std::make_shared<DevelUpdates>(pixels);
+    auto timers = std::make_shared<TimerWheel>();
 
-    DoHardwareStartupTests(pixels, settings, rtc, joy);
+    // a startup flow gets a frame at a time, while the RTC, timers and OTA
+    // keep running, until it's done and the displays take the buttons over
+    auto startup = DoHardwareStartupTests(pixels, settings, rtc, joy);
+    while (startup && startup->Resume(millis())) {
+        timers->Update(millis());
+        rtc->Update();
+        joy->Update();
+        develUpdates->Update();
+        joy->WaitForInput(1000 / FRAMES_PER_SECOND);
+    }
 
     // These are the "displays" that are available, but more can be added. The
     // DisplayMgr navigates between them using left/right motions, if the
     // Display allows it (e.g. holding left at the Clock activates SetTime)
     auto displayMgr =
-        std::make_shared<DisplayManager>(pixels, settings, rtc, joy);
+        std::make_shared<DisplayManager>(pixels, settings, rtc, joy, timers);
 
     displayMgr->Add(std::make_shared<SetTime>(rtc));
     displayMgr->Add(std::make_shared<Clock>(rtc));
@@ -32,14 +43,15 @@ void setup() {
 
     // 0 = SetTime   <=>   1 = Clock   <=>   2 = ConfigMenu
     displayMgr->SetDefaultAndActivateDisplay(1);
+    StartSerialStatus(timers, pixels, settings, rtc);
 
     for (;;) {  // forever, instead of loop(), because I avoid globals ;)
-        ShowSerialStatusMessage(pixels, rtc);
+        timers->Update(millis());
         rtc->Update();
         joy->Update();
         develUpdates->Update();
         displayMgr->Update();
-        yield();  // allow the ESP platform tasks to run
+        WaitForNextEvent(rtc, settings, timers, displayMgr->IsIdle());
     }
 }
 
@@ -0,0 +1,33 @@
+#include <palettes.hpp>
+
+static const Palette::Stops STOPS[PALETTE_TOTAL] = {
+    // PALETTE_RAINBOW is generated, see Expand()
+    {},
+    // PALETTE_CANDLE
+    {0x400000, 0x800400, 0xC01000, 0xFF2800, 0xFF4800, 0xFF6A08,
+     0xFF8C18, 0xFFA838, 0xFFC870, 0xFFA838, 0xFF8C18, 0xFF6A08,
+     0xFF4800, 0xFF2800, 0xC01000, 0x800400},
+    // PALETTE_OCEAN
+    {0x000040, 0x000080, 0x0010C0, 0x0030FF, 0x0060FF, 0x0090E0,
+     0x00B0C0, 0x20D0C0, 0x60F0E0, 0x20D0C0, 0x00B0C0, 0x0090E0,
+     0x0060FF, 0x0030FF, 0x0010C0, 0x000080},
+    // PALETTE_FOREST
+    {0x004000, 0x006000, 0x108000, 0x30A000, 0x60B000, 0x90C000,
+     0xC0C000, 0x808000, 0x406000, 0x008020, 0x00A040, 0x00C060,
+     0x20A030, 0x208010, 0x106000, 0x005000},
+    // PALETTE_PASTEL
+    {0xFF8080, 0xFF90A8, 0xFFA0D0, 0xE0A0FF, 0xB0A0FF, 0x90B0FF,
+     0x90D0FF, 0x90FFF0, 0x90FFC0, 0xA8FFA0, 0xD0FF90, 0xFFFF90,
+     0xFFE090, 0xFFC090, 0xFFA090, 0xFF9088},
+    // PALETTE_ICE
+    {0xFFFFFF, 0xE0F0FF, 0xC0E0FF, 0xA0D0FF, 0x80C0FF, 0x60B0FF,
+     0x4090FF, 0x3070FF, 0x4060FF, 0x6070FF, 0x8080FF, 0xA0A0FF,
+     0xB0C0FF, 0xC0E0FF, 0xE0F0FF, 0xF0F8FF},
+};
+
+Palette::Lut Palette::Expand(const Palette_e palette) {
+    if (palette == PALETTE_RAINBOW || palette >= PALETTE_TOTAL) {
+        return Rainbow();
+    }
+    return Expand(STOPS[palette]);
+}
@@ -1,16 +1,61 @@
+#include <characters/digit_glyphs.hpp>
 #include <pixels.hpp>
 
-Pixels::Pixels(std::shared_ptr<Settings> settings)
-    : m_neoPixels(TOTAL_ALL_LEDS, PIN_LEDS), m_settings(settings) {
+// the pin of each output, for geometries with more than one (PIN_LEDS_1 and
+// so on come from the build flags)
+static const uint8_t LED_OUTPUT_PINS[] = {
+    PIN_LEDS,
+#ifdef PIN_LEDS_1
+    PIN_LEDS_1,
+#endif
+#ifdef PIN_LEDS_2
+    PIN_LEDS_2,
+#endif
+#ifdef PIN_LEDS_3
+    PIN_LEDS_3,
+#endif
+};
+
+// per-LED calibration, stored as a CalibrationHeader followed by one
+// Calibration (4 bytes) per LED in logical order
+static const char* CALIBRATION_FILE = "/calibration.bin";
+
+struct CalibrationHeader {
+    char magic[4];
+    uint8_t version;
+    uint8_t reserved;
+    uint16_t count;
+};
+static const char CALIBRATION_MAGIC[4] = {'F', 'C', 'A', 'L'};
+enum { CALIBRATION_VERSION = 1 };
+
+template <typename Geometry>
+BasicPixels<Geometry>::BasicPixels(std::shared_ptr<Settings> settings)
+    : m_outputs(MakeBus), m_settings(settings) {
 #if FCOS_ESP8266
     // TODO: check whether this is needed
     pinMode(PIN_LEDS, OUTPUT);
 #endif
-    m_neoPixels.Begin();
+    m_outputs.Begin();
+    m_channelSums.resize(Geometry::TOTAL_LEDS);
 
     if (!(*settings).containsKey("MINB")) {
         (*settings)["MINB"] = String(MIN_DISPLAY_BRIGHTNESS_DEFAULT);
     }
+    if (!(*settings).containsKey("PWR_MA")) {
+        (*settings)["PWR_MA"] = POWER_BUDGET_MA_DEFAULT;
+    }
+    m_powerBudgetMa = (*m_settings)["PWR_MA"].as<int>();
+
+    if (!(*settings).containsKey("WARM")) {
+        (*settings)["WARM"] = 0;
+    }
+
+    if (!(*settings).containsKey("PAL")) {
+        (*settings)["PAL"] = String(PALETTE_RAINBOW + 1);
+    }
+    m_palette = GetSelectedPalette();
+    s_palette = Palette::Expand((Palette_e)m_palette);
 
 #if FCOS_FOXIECLOCK
     m_isPXLmode = ((*m_settings)["PXL"] == "1");
@@ -28,47 +73,79 @@ Pixels::Pixels(std::shared_ptr<Settings> settings)
     m_lightSensor.SetHwMax((*m_settings)["LS_HW_MAX"].as<int>());
     m_lightSensor.ResetToCurrentSensorValue();
 
+    LoadCalibration();
     SetLEDBrightnessMultiplierFromSensor();
 }
 
-void Pixels::Update() {
+template <typename Geometry>
+void BasicPixels<Geometry>::Update() {
     if (m_sinceLastLightSensorUpdate.Ms() >= LIGHT_SENSOR_UPDATE_MS) {
         m_sinceLastLightSensorUpdate.Reset();
         SetLEDBrightnessMultiplierFromSensor();
     }
+    UpdatePalette();
 
 #if FCOS_FOXIECLOCK
-    m_isPXLmode = ((*m_settings)["PXL"] == "1");
+    const bool isPXLmode = ((*m_settings)["PXL"] == "1");
+    if (isPXLmode != m_isPXLmode) {
+        m_isPXLmode = isPXLmode;
+        UpdateGainTable();
+    }
 #endif
     Show();
 }
 
-void Pixels::Show() {
-    m_neoPixels.Show();
+template <typename Geometry>
+void BasicPixels<Geometry>::Show() {
+    LimitPower();
+
+    // the idle detection only needs to know whether anything changed, the
+    // number of LEDs is for the stats
+    m_lastFrameChanged =
+        m_outputs.DiffFrame(m_lastFrame, m_frameStats.IsEnabled());
+
+    const unsigned long beginUs = micros();
+    m_outputs.Show();
+    m_frameStats.EndFrame(m_lastFrameChanged, micros() - beginUs);
 }
 
-void Pixels::Clear(const RgbColor color,
-                   const bool includeOptionLEDs,
-                   const bool includeRoundLEDs) {
-    const size_t numToClear = TOTAL_MATRIX_LEDS +
-                              (includeOptionLEDs ? OPTION_LEDS : 0) +
-                              (includeRoundLEDs ? ROUND_LEDS : 0);
+template <typename Geometry>
+void BasicPixels<Geometry>::Clear(const RgbColor color,
+                                  const bool includeOptionLEDs,
+                                  const bool includeRoundLEDs) {
+    const size_t numToClear = Geometry::MATRIX_LEDS +
+                              (includeOptionLEDs ? Geometry::OPTION_LEDS : 0) +
+                              (includeRoundLEDs ? Geometry::ROUND_LEDS : 0);
     for (size_t i = 0; i < numToClear; ++i) {
-        m_neoPixels.SetPixelColor(i, color);
+        SetLED(i, color);
     }
 }
 
-void Pixels::Darken(const size_t numTimes,
-                    const float amount,
-                    const size_t delayMs) {
-    const size_t numToClear = TOTAL_MATRIX_LEDS + OPTION_LEDS + ROUND_LEDS;
+template <typename Geometry>
+void BasicPixels<Geometry>::Darken(const size_t numTimes,
+                                   const float amount,
+                                   const size_t delayMs) {
+    if (m_renderTarget) {
+        // an off-screen buffer isn't shown in between, so the passes can be
+        // folded into one
+        const uint32_t scale = PixelMath::RepeatedScale(amount, numTimes);
+        for (auto& color : *m_renderTarget) {
+            if (color != BLACK) {
+                color = RgbColor(PixelMath::ScaleChannel(color.R, scale),
+                                 PixelMath::ScaleChannel(color.G, scale),
+                                 PixelMath::ScaleChannel(color.B, scale));
+            }
+        }
+        return;
+    }
+
     for (size_t t = 0; t < numTimes; ++t) {
-        for (size_t i = 0; i < numToClear; ++i) {
-            RgbColor color = m_neoPixels.GetPixelColor(i);
+        for (size_t i = 0; i < Geometry::TOTAL_LEDS; ++i) {
+            RgbColor color = GetLED(i);
             if (color == BLACK) {
                 continue;
             }
-            m_neoPixels.SetPixelColor(i, ScaleBrightness(color, amount));
+            SetLED(i, ScaleBrightness(color, amount));
         }
 
         if (numTimes > 1) {
@@ -78,53 +155,47 @@ void Pixels::Darken(const size_t numTimes,
     }
 }
 
-void Pixels::Set(const int pos,
-                 const RgbColor color,
-                 const bool skipBrightnessScaling) {
-    if (skipBrightnessScaling || color == BLACK) {
-        m_neoPixels.SetPixelColor(pos, color);
-    } else {
-        float adjustedBrightness = m_adjustedBrightness;
-        if (!m_isPXLmode && (!m_useDarkMode || GetBrightness() >= 0.04f)) {
-            // this code increases the brightness of the LEDs
-            // for the 3-9 digits so that they shine brighter
-            // through the acrylics in front of them
-            float multiplier = 0.0004f;
-            if (GetBrightness() >= 0.04f) {
-                multiplier += GetBrightness() * 0.1f;
-            }
-            if (pos < 14) {  // digit 1
-                adjustedBrightness += (14 - pos) * multiplier;
-            } else if (pos >= 20 && pos < 34) {  // digit 2
-                adjustedBrightness += (34 - pos) * multiplier;
-            } else if (pos >= 42 && pos < 56) {  // digit 3
-                adjustedBrightness += (56 - pos) * multiplier;
-            } else if (pos >= 62 && pos < 76) {  // digit 4
-                adjustedBrightness += (76 - pos) * multiplier;
-            }
-
-            if (adjustedBrightness > 0.9f) {
-                adjustedBrightness = 0.9f;
-            }
+template <typename Geometry>
+void BasicPixels<Geometry>::Set(const int pos,
+                                const RgbColor color,
+                                const bool skipBrightnessScaling) {
+    if (m_layerTarget) {
+        if (pos >= 0 && pos < Geometry::MATRIX_LEDS) {
+            m_layerTarget->Set(pos % Geometry::WIDTH, pos / Geometry::WIDTH,
+                               color);
         }
-        RgbColor scaledColor = ScaleBrightness(color, adjustedBrightness);
-        m_neoPixels.SetPixelColor(pos, scaledColor);
+        return;
+    }
+    if (skipBrightnessScaling || color == BLACK) {
+        SetPixelColor(pos, color);
+    } else if (pos >= 0 && pos < Geometry::TOTAL_LEDS) {
+        // calibration gains above 1.0 can push a channel past 255
+        const uint32_t* gain = &m_gain[pos * 3];
+        const uint32_t power = m_powerScale;
+        SetPixelColor(pos,
+                      RgbColor(PixelMath::ScaleChannel(color.R, gain[0], power),
+                               PixelMath::ScaleChannel(color.G, gain[1], power),
+                               PixelMath::ScaleChannel(color.B, gain[2], power)));
     }
 }
-void Pixels::Set(const int x,
-                 const int y,
-                 const RgbColor color,
-                 const bool force) {
-    if (x >= 0 && x <= DISPLAY_WIDTH && y >= 0 && y < DISPLAY_HEIGHT) {
-        Set(y * DISPLAY_WIDTH + x, color, force);
+
+template <typename Geometry>
+void BasicPixels<Geometry>::Set(const int x,
+                                const int y,
+                                const RgbColor color,
+                                const bool force) {
+    if (x >= 0 && x < Geometry::WIDTH && y >= 0 && y < Geometry::HEIGHT) {
+        Set(y * Geometry::WIDTH + x, color, force);
     }
 }
 
-int Pixels::DrawText(int x, String text, const RgbColor color) {
+template <typename Geometry>
+int BasicPixels<Geometry>::DrawText(int x, String text, const RgbColor color) {
     return DrawText(x, 0, text, color);
 }
 
-int Pixels::DrawText(int x, int y, String text, const RgbColor color) {
+template <typename Geometry>
+int BasicPixels<Geometry>::DrawText(int x, int y, String text, const RgbColor color) {
     text.toUpperCase();
     int textWidth = 0;
 
@@ -136,19 +207,23 @@ int Pixels::DrawText(int x, int y, String text, const RgbColor color) {
     return textWidth;
 }
 
-int Pixels::DrawChar(int x, char character, const RgbColor color) {
+template <typename Geometry>
+int BasicPixels<Geometry>::DrawChar(int x, char character, const RgbColor color) {
     return DrawChar(x, 0, character, color, color);
 }
 
-int Pixels::DrawChar(int x, char character, const RgbColor beginColor, const RgbColor endColor) {
+template <typename Geometry>
+int BasicPixels<Geometry>::DrawChar(int x, char character, const RgbColor beginColor, const RgbColor endColor) {
     return DrawChar(x, 0, character, beginColor, endColor);
 }
 
-int Pixels::DrawChar(int x, int y, char character, const RgbColor color) {
+template <typename Geometry>
+int BasicPixels<Geometry>::DrawChar(int x, int y, char character, const RgbColor color) {
     return DrawChar(x, y, character, color, color);
 }
 
-int Pixels::DrawChar(int x, int y, char character, const RgbColor beginColor, const RgbColor endColor) {
+template <typename Geometry>
+int BasicPixels<Geometry>::DrawChar(int x, int y, char character, const RgbColor beginColor, const RgbColor endColor) {
     std::vector<uint8_t> charData;
     // clang-format off
         // --------------- 
@@ -191,7 +266,7 @@ int Pixels::DrawChar(int x, int y, char character, const RgbColor beginColor, co
         // Draw the character with gradient
         for (int row = 0; row < CHAR_HEIGHT; ++row) {
             for (int column = x; column < x + charWidth; ++column) {
-                if (column >= 0 && column < DISPLAY_WIDTH && *data) {
+                if (column >= 0 && column < Geometry::WIDTH && *data) {
                     // Calculate gradient color based on position
                     float progress = (float)activePixelCount / (totalActivePixels - 1);
                     if (totalActivePixels == 1) {
@@ -208,9 +283,7 @@ int Pixels::DrawChar(int x, int y, char character, const RgbColor beginColor, co
 
         return charWidth + 1;
 #elif FCOS_FOXIECLOCK
-        // hax to ignore the blinker LEDs in the middle
-        if (x == 40 || x == 41) { x = 42; }
-        if (x == 60 || x == 61) { x = 62; }
+        x = Geometry::TextColumn(x);
 
         if (m_isPXLmode) {
 #include "characters/fc2-pxl.inc"
@@ -297,37 +370,48 @@ int Pixels::DrawChar(int x, int y, char character, const RgbColor beginColor, co
 #endif
 }
 
-RgbColor Pixels::ColorWheel(uint8_t pos) {
-    return HslColor(pos / 255.0f, 1.0f, 0.5);
-}
-
-float Pixels::GetBrightness() {
+template <typename Geometry>
+float BasicPixels<Geometry>::GetBrightness() {
     return m_currentBrightness;
 }
 
-RgbColor Pixels::ScaleBrightness(const RgbColor color, const float brightness) {
+template <typename Geometry>
+RgbColor BasicPixels<Geometry>::ScaleBrightness(const RgbColor color, const float brightness) {
     return color.LinearBlend(BLACK, color, brightness);
 }
 
-void Pixels::ToggleDarkMode() {
+template <typename Geometry>
+void BasicPixels<Geometry>::ToggleDarkMode() {
     m_useDarkMode = !m_useDarkMode;
+    UpdateGainTable();
 }
 
-void Pixels::EnableDarkMode() {
+template <typename Geometry>
+void BasicPixels<Geometry>::EnableDarkMode() {
     m_useDarkMode = true;
+    UpdateGainTable();
 }
 
-void Pixels::DisableDarkMode() {
+template <typename Geometry>
+void BasicPixels<Geometry>::DisableDarkMode() {
     m_useDarkMode = false;
+    UpdateGainTable();
 }
 
-bool Pixels::IsDarkModeEnabled() {
+template <typename Geometry>
+bool BasicPixels<Geometry>::IsDarkModeEnabled() {
     return m_useDarkMode;
 }
 
-void Pixels::DrawColorWheelBetween(uint8_t wheelPos,
-                                   const size_t x1,
-                                   const size_t x2) {
+template <typename Geometry>
+bool BasicPixels<Geometry>::IsPXLModeEnabled() {
+    return m_isPXLmode;
+}
+
+template <typename Geometry>
+void BasicPixels<Geometry>::DrawColorWheelBetween(uint8_t wheelPos,
+                                                  const size_t x1,
+                                                  const size_t x2) {
     const size_t steps = x2 - x1;
     for (size_t i = 0; i < steps; ++i) {
         RgbColor color = ColorWheel(wheelPos);
@@ -340,20 +424,24 @@ void Pixels::DrawColorWheelBetween(uint8_t wheelPos,
 // TODO: Move these functions into a CC-specific version of Pixels
 
 // if pos == 0 then LED is at the 1:00 position
-void Pixels::DrawRingLED(const int ringNum,
-                         const int pos,
-                         const RgbColor color,
-                         const bool forceColor) {
-    Set(FIRST_RING_LED + (ringNum * RING_SIZE) + pos, color, forceColor);
-}
-
-void Pixels::ClearRoundLEDs(const RgbColor color) {
-    for (size_t i = FIRST_RING_LED; i < TOTAL_ALL_LEDS; ++i) {
+template <typename Geometry>
+void BasicPixels<Geometry>::DrawRingLED(const int ringNum,
+                                        const int pos,
+                                        const RgbColor color,
+                                        const bool forceColor) {
+    Set(Geometry::FIRST_RING_LED + (ringNum * Geometry::RING_SIZE) + pos,
+        color, forceColor);
+}
+
+template <typename Geometry>
+void BasicPixels<Geometry>::ClearRoundLEDs(const RgbColor color) {
+    for (size_t i = Geometry::FIRST_RING_LED; i < Geometry::TOTAL_LEDS; ++i) {
         Set(i, color, true);
     }
 }
 
-void Pixels::DrawColorWheel(const uint8_t bottomPixelWheelPos) {
+template <typename Geometry>
+void BasicPixels<Geometry>::DrawColorWheel(const uint8_t bottomPixelWheelPos) {
     uint8_t wheelPos = bottomPixelWheelPos - 128;
     for (size_t i = 0; i < 12; ++i) {
         RgbColor color = ColorWheel(wheelPos);
@@ -366,13 +454,13 @@ void Pixels::DrawColorWheel(const uint8_t bottomPixelWheelPos) {
     }
 }
 
-void Pixels::DrawTextScrolling(const String& text,
-                               const RgbColor color,
-                               const size_t delayMs) {
+template <typename Geometry>
+void BasicPixels<Geometry>::DrawTextScrolling(const String& text,
+                                              const RgbColor color,
+                                              const size_t delayMs) {
     const auto length = DrawText(0, text, color);
 
-    ElapsedTime waitToScroll;
-    for (int i = DISPLAY_WIDTH; i > -length;) {
+    for (int i = Geometry::WIDTH; i > -length;) {
         Clear();
         int yPos = 0;
 #if FCOS_CARDCLOCK2
@@ -380,26 +468,19 @@ void Pixels::DrawTextScrolling(const String& text,
 #endif
 
         DrawText(i, yPos, text, color);
-        // pressing a button will speed up a long blocking scrolling
-        // message
-        waitToScroll.Reset();
-        size_t adjustedDelay = delayMs;
-        while (waitToScroll.Ms() < adjustedDelay) {
-            Update();
-            // adjustedDelay = Button::AreAnyButtonsPressed() != -1
-            //                     ? delayMs / 3
-            //                     : delayMs;
-            yield();
-        }
+        Update();
+        ElapsedTime::Delay(delayMs);
         --i;
     }
 }
 
-void Pixels::DrawHourLED(const int hour, const RgbColor color) {
+template <typename Geometry>
+void BasicPixels<Geometry>::DrawHourLED(const int hour, const RgbColor color) {
     DrawRingLED(0, hour - 1, color);
 }
 
-void Pixels::DrawMinuteLED(const int minute, const RgbColor color) {
+template <typename Geometry>
+void BasicPixels<Geometry>::DrawMinuteLED(const int minute, const RgbColor color) {
     // represent 60 seconds using 12 LEDs, 60 / 12 = 5
     // 0 seconds is at the 12th LED, so subtract 1
     int minuteLED = minute / 5;
@@ -415,9 +496,10 @@ void Pixels::DrawMinuteLED(const int minute, const RgbColor color) {
 #endif
 }
 
-void Pixels::DrawSecondLEDs(const int second,
-                            const RgbColor color,
-                            const int brightestLED) {
+template <typename Geometry>
+void BasicPixels<Geometry>::DrawSecondLEDs(const int second,
+                                           const RgbColor color,
+                                           const int brightestLED) {
     int secondLED = second / 5;
     if (secondLED == 0) {
         secondLED = 11;
@@ -450,56 +532,148 @@ void Pixels::DrawSecondLEDs(const int second,
 }
 #endif
 
-void Pixels::Move(const int fromCol,
-                  const int fromRow,
-                  const int toCol,
-                  const int toRow) {
+template <typename Geometry>
+void BasicPixels<Geometry>::Move(const int fromCol,
+                                 const int fromRow,
+                                 const int toCol,
+                                 const int toRow) {
     RgbColor color =
-        m_neoPixels.GetPixelColor(fromRow * DISPLAY_WIDTH + fromCol);
+        GetLED(fromRow * Geometry::WIDTH + fromCol);
 
-    if (toCol >= 0 && toCol < DISPLAY_WIDTH && toRow >= 0 &&
-        toRow < DISPLAY_HEIGHT) {
+    if (toCol >= 0 && toCol < Geometry::WIDTH && toRow >= 0 &&
+        toRow < Geometry::HEIGHT) {
         Set(toCol, toRow, color, true);  // force color
         Set(fromCol, fromRow, BLACK);
     }
 }
 
-void Pixels::Move(const int from, const int to) {
-    RgbColor color = m_neoPixels.GetPixelColor(from);
+template <typename Geometry>
+void BasicPixels<Geometry>::Move(const int from, const int to) {
+    RgbColor color = GetLED(from);
     Set(to, color);
     Set(from, BLACK);
 }
 
-void Pixels::MoveHorizontal(const int num) {
-    for (int row = 0; row < DISPLAY_HEIGHT; ++row) {
+template <typename Geometry>
+void BasicPixels<Geometry>::MoveHorizontal(const int num) {
+    for (int row = 0; row < Geometry::HEIGHT; ++row) {
         if (num < 0) {
-            for (int column = 1; column < DISPLAY_WIDTH; ++column) {
+            for (int column = 1; column < Geometry::WIDTH; ++column) {
                 Move(column, row, column + num, row);
             }
         } else {
-            for (int column = DISPLAY_WIDTH - 2; column >= 0; --column) {
+            for (int column = Geometry::WIDTH - 2; column >= 0; --column) {
                 Move(column, row, column + num, row);
             }
         }
     }
 }
 
-void Pixels::MoveVertical(const int num) {
+template <typename Geometry>
+void BasicPixels<Geometry>::MoveVertical(const int num) {
     if (num < 0) {
-        for (int row = 1; row < DISPLAY_HEIGHT; ++row) {
-            for (int column = 0; column < DISPLAY_WIDTH; ++column) {
+        for (int row = 1; row < Geometry::HEIGHT; ++row) {
+            for (int column = 0; column < Geometry::WIDTH; ++column) {
                 Move(column, row, column, row + num);
             }
         }
     } else {
-        for (int row = DISPLAY_HEIGHT - 2; row >= 0; --row) {
-            for (int column = 0; column < DISPLAY_WIDTH; ++column) {
+        for (int row = Geometry::HEIGHT - 2; row >= 0; --row) {
+            for (int column = 0; column < Geometry::WIDTH; ++column) {
                 Move(column, row, column, row + num);
             }
         }
     }
 }
-void Pixels::SetLEDBrightnessMultiplierFromSensor() {
+template <typename Geometry>
+void BasicPixels<Geometry>::SetRenderTarget(Buffer* target) {
+    m_renderTarget = target;
+    if (m_renderTarget) {
+        m_renderTarget->resize(Geometry::MATRIX_LEDS, BLACK);
+    }
+}
+
+template <typename Geometry>
+void BasicPixels<Geometry>::SetLayerTarget(Layer* layer) {
+    m_layerTarget = layer;
+}
+
+template <typename Geometry>
+void BasicPixels<Geometry>::CopyMatrixTo(Buffer& buffer) {
+    buffer.resize(Geometry::MATRIX_LEDS);
+    for (size_t i = 0; i < Geometry::MATRIX_LEDS; ++i) {
+        buffer[i] = GetLED(i);
+    }
+}
+
+template <typename Geometry>
+void BasicPixels<Geometry>::BlendMatrix(const Buffer& from,
+                                        const Buffer& to,
+                                        const uint8_t amount) {
+    // the buffers were already brightness scaled when they were drawn, so
+    // this is just an integer lerp per LED
+    for (size_t i = 0; i < Geometry::MATRIX_LEDS; ++i) {
+        SetLED(i, RgbColor::LinearBlend(from[i], to[i], amount));
+    }
+}
+
+template <typename Geometry>
+void BasicPixels<Geometry>::ComposeLayer(Layer& layer) {
+    const uint32_t keep =
+        Layer::Keep(layer.m_sinceDecay.Ms(), layer.m_halfLifeMs);
+    layer.m_sinceDecay.Reset();
+
+    for (size_t i = 0; i < Geometry::MATRIX_LEDS; ++i) {
+        Set(i, layer.Get(i));
+        layer.Fade(i, keep);
+    }
+}
+
+template <typename Geometry>
+BasicPixels<Geometry>::Layer::Layer(const uint16_t halfLifeMs) {
+    SetHalfLife(halfLifeMs);
+}
+
+template <typename Geometry>
+void BasicPixels<Geometry>::Layer::SetHalfLife(const uint16_t halfLifeMs) {
+    m_halfLifeMs = std::max<uint16_t>(1, halfLifeMs);
+}
+
+template <typename Geometry>
+void BasicPixels<Geometry>::Layer::Set(const int x, const int y, const RgbColor color) {
+    Trail::Set(x, y, color.R, color.G, color.B);
+}
+
+template <typename Geometry>
+void BasicPixels<Geometry>::Layer::Splat(const float x, const float y, const RgbColor color) {
+    Trail::Splat(x, y, color.R, color.G, color.B);
+}
+
+template <typename Geometry>
+RgbColor BasicPixels<Geometry>::Layer::Get(const int pos) const {
+    return RgbColor(Trail::Get(pos, 0), Trail::Get(pos, 1), Trail::Get(pos, 2));
+}
+
+template <typename Geometry>
+std::unique_ptr<typename BasicPixels<Geometry>::Bus>
+BasicPixels<Geometry>::MakeBus(const int output, const uint16_t numLEDs) {
+    if constexpr (Geometry::NUM_OUTPUTS == 1) {
+        return std::make_unique<Bus>(numLEDs, PIN_LEDS);
+    } else {
+        static_assert(Geometry::NUM_OUTPUTS <= sizeof(LED_OUTPUT_PINS),
+                      "define PIN_LEDS_1 and up for every extra output");
+#if CONFIG_IDF_TARGET_ESP32C3
+        // a third output would compile, but fail to get an RMT channel
+        static_assert(Geometry::NUM_OUTPUTS <= 2,
+                      "the ESP32-C3 only has 2 RMT TX channels");
+#endif
+        return std::make_unique<Bus>(numLEDs, LED_OUTPUT_PINS[output],
+                                     (NeoBusChannel)output);
+    }
+}
+
+template <typename Geometry>
+void BasicPixels<Geometry>::SetLEDBrightnessMultiplierFromSensor() {
     // TEMPORARY:
     m_lightSensor.SetHwMin((*m_settings)["LS_HW_MIN"].as<int>());
     m_lightSensor.SetHwMax((*m_settings)["LS_HW_MAX"].as<int>());
@@ -514,16 +688,277 @@ void Pixels::SetLEDBrightnessMultiplierFromSensor() {
         configuredMinBrightness = 0;
     }
 
+    float maxBrightness;
     if (m_isPXLmode) {
         m_adjustedBrightness = pixelMinBrightness +
                                (0.004f * configuredMinBrightness) +
                                (m_currentBrightness * 0.08f);
+        maxBrightness = 0.008f + (0.004f * MAX_DISPLAY_BRIGHTNESS) + 0.08f;
     } else {
         m_adjustedBrightness = pixelMinBrightness +
                                (0.04f * configuredMinBrightness) +
                                (m_currentBrightness * 0.9f);
-        if (m_adjustedBrightness > 0.9f) {
-            m_adjustedBrightness = 0.9f;
+        maxBrightness = 0.9f;
+    }
+    maxBrightness *= (float)m_maxBrightness / MAX_DISPLAY_BRIGHTNESS;
+    if (m_adjustedBrightness > maxBrightness) {
+        m_adjustedBrightness = maxBrightness;
+    }
+    UpdateWhitePoint();
+    if (IsGainTableStale()) {
+        UpdateGainTable();
+    }
+}
+
+template <typename Geometry>
+typename BasicPixels<Geometry>::Calibration
+BasicPixels<Geometry>::GetCalibration(const int pos) {
+    if (pos < 0 || pos >= Geometry::TOTAL_LEDS) {
+        return Calibration();
+    }
+    return m_calibration[pos];
+}
+
+template <typename Geometry>
+void BasicPixels<Geometry>::SetCalibration(const int pos,
+                                           const Calibration& calibration) {
+    if (pos < 0 || pos >= Geometry::TOTAL_LEDS) {
+        return;
+    }
+    m_calibration[pos] = calibration;
+    UpdateGainTable();
+}
+
+template <typename Geometry>
+void BasicPixels<Geometry>::ResetCalibration() {
+    m_calibration.assign(Geometry::TOTAL_LEDS, Calibration());
+#if FCOS_FOXIECLOCK
+    // the edge-lit LEDs of the 3-9 digits need to be brighter to shine
+    // through the acrylics in front of them
+    for (int pos = 0; pos < Geometry::MATRIX_LEDS; ++pos) {
+        if (pos < 14) {  // digit 1
+            m_calibration[pos].edgeBoost = 14 - pos;
+        } else if (pos >= 20 && pos < 34) {  // digit 2
+            m_calibration[pos].edgeBoost = 34 - pos;
+        } else if (pos >= 42 && pos < 56) {  // digit 3
+            m_calibration[pos].edgeBoost = 56 - pos;
+        } else if (pos >= 62 && pos < 76) {  // digit 4
+            m_calibration[pos].edgeBoost = 76 - pos;
+        }
+    }
+#endif
+    UpdateGainTable();
+}
+
+template <typename Geometry>
+void BasicPixels<Geometry>::LoadCalibration() {
+    ResetCalibration();
+
+    File file = LittleFS.open(CALIBRATION_FILE, "r");
+    if (!file) {
+        return;
+    }
+    CalibrationHeader header;
+    std::vector<Calibration> calibration(Geometry::TOTAL_LEDS);
+    const size_t size = calibration.size() * sizeof(Calibration);
+    const bool valid =
+        file.read((uint8_t*)&header, sizeof(header)) == sizeof(header) &&
+        memcmp(header.magic, CALIBRATION_MAGIC, sizeof(header.magic)) == 0 &&
+        header.version == CALIBRATION_VERSION &&
+        header.count == Geometry::TOTAL_LEDS &&
+        file.read((uint8_t*)calibration.data(), size) == size;
+    file.close();
+
+    if (!valid) {
+        // a file from another board or an older version would put the
+        // corrections on the wrong LEDs, so it's better to ignore it
+        DPRINT("Ignoring invalid LED calibration\n");
+        return;
+    }
+    m_calibration = calibration;
+    UpdateGainTable();
+}
+
+template <typename Geometry>
+bool BasicPixels<Geometry>::SaveCalibration() {
+    LittleFS.remove(CALIBRATION_FILE);
+    File file = LittleFS.open(CALIBRATION_FILE, "w+");
+    if (!file) {
+        return false;
+    }
+    CalibrationHeader header;
+    memcpy(header.magic, CALIBRATION_MAGIC, sizeof(header.magic));
+    header.version = CALIBRATION_VERSION;
+    header.reserved = 0;
+    header.count = Geometry::TOTAL_LEDS;
+    const size_t size = m_calibration.size() * sizeof(Calibration);
+    const bool success =
+        file.write((const uint8_t*)&header, sizeof(header)) == sizeof(header) &&
+        file.write((const uint8_t*)m_calibration.data(), size) == size;
+    file.close();
+
+    return success;
+}
+
+template <typename Geometry>
+bool BasicPixels<Geometry>::IsGainTableStale() const {
+    return m_adjustedBrightness != m_gainInputs.adjustedBrightness ||
+           m_currentBrightness != m_gainInputs.brightness ||
+           m_whitePointStep != m_gainInputs.whitePointStep ||
+           m_isPXLmode != m_gainInputs.isPXLmode ||
+           m_useDarkMode != m_gainInputs.useDarkMode;
+}
+
+template <typename Geometry>
+void BasicPixels<Geometry>::UpdateGainTable() {
+    if (m_adjustedBrightness < 0) {
+        // the constructor loads the calibration before the light sensor's
+        // first reading, which builds the table
+        return;
+    }
+    m_gainInputs = {m_adjustedBrightness, m_currentBrightness,
+                    m_whitePointStep, m_isPXLmode, m_useDarkMode};
+
+    // the edge-lit boost was worked out per pixel in Set() before, this
+    // keeps the same curve in the table
+    const bool boostEdgeLit =
+        !m_isPXLmode && (!m_useDarkMode || GetBrightness() >= 0.04f);
+    float multiplier = 0.0004f;
+    if (GetBrightness() >= 0.04f) {
+        multiplier += GetBrightness() * 0.1f;
+    }
+
+    m_gain.resize(Geometry::TOTAL_LEDS * 3);
+    for (int pos = 0; pos < Geometry::TOTAL_LEDS; ++pos) {
+        const Calibration& cal = m_calibration[pos];
+        float level = m_adjustedBrightness;
+        if (boostEdgeLit && cal.edgeBoost) {
+            level = std::min(level + cal.edgeBoost * multiplier, 0.9f);
+        }
+        const float scale = level * 65536.0f / CALIBRATION_UNITY;
+        m_gain[pos * 3] = cal.r * scale * m_whitePoint.r;
+        m_gain[pos * 3 + 1] = cal.g * scale * m_whitePoint.g;
+        m_gain[pos * 3 + 2] = cal.b * scale * m_whitePoint.b;
+    }
+}
+
+template <typename Geometry>
+int BasicPixels<Geometry>::GetSelectedPalette() {
+    const int palette = (*m_settings)["PAL"].as<int>() - 1;
+    return std::max(0, std::min(palette, PALETTE_TOTAL - 1));
+}
+
+template <typename Geometry>
+void BasicPixels<Geometry>::UpdatePalette() {
+    const int palette = GetSelectedPalette();
+    if (palette != m_palette) {
+        // start from whatever is showing, which may be part way through
+        // another cross-fade
+        m_palette = palette;
+        m_paletteFrom = s_palette;
+        m_paletteTo = Palette::Expand((Palette_e)palette);
+        m_sincePaletteChange.Reset();
+        m_isBlendingPalette = true;
+    }
+    if (!m_isBlendingPalette) {
+        return;
+    }
+
+    const size_t elapsed = m_sincePaletteChange.Ms();
+    if (elapsed >= PALETTE_BLEND_MS) {
+        s_palette = m_paletteTo;
+        m_isBlendingPalette = false;
+    } else {
+        Palette::Blend(m_paletteFrom, m_paletteTo,
+                       elapsed * 256 / PALETTE_BLEND_MS, s_palette);
+    }
+}
+
+template <typename Geometry>
+void BasicPixels<Geometry>::SetTimeOfDay(const int hour, const int minute) {
+    m_minuteOfDay = hour * 60 + minute;
+    if (UpdateWhitePoint()) {
+        UpdateGainTable();
+    }
+}
+
+template <typename Geometry>
+void BasicPixels<Geometry>::SetMaxBrightness(const int maxBrightness) {
+    m_maxBrightness =
+        std::max(1, std::min(maxBrightness, (int)MAX_DISPLAY_BRIGHTNESS));
+    SetLEDBrightnessMultiplierFromSensor();
+}
+
+template <typename Geometry>
+bool BasicPixels<Geometry>::UpdateWhitePoint() {
+    const int warmth =
+        std::max(0, std::min((*m_settings)["WARM"].as<int>(), (int)MAX_WARMTH));
+    // the warmth only depends on the light up to 1/4 of the sensor's range
+    const int lightStep = std::min(GetBrightness() * 4, 1.0f) *
+                          (WHITE_POINT_LIGHT_STEPS - 1);
+    const int timeStep = m_minuteOfDay / WHITE_POINT_MINUTES;
+    const int step =
+        warmth ? (warmth * (24 * 60 / WHITE_POINT_MINUTES) + timeStep) *
+                         WHITE_POINT_LIGHT_STEPS +
+                     lightStep
+               : 0;
+    if (step == m_whitePointStep) {
+        return false;
+    }
+    m_whitePointStep = step;
+
+    const float ambient =
+        lightStep / (4.0f * (WHITE_POINT_LIGHT_STEPS - 1));
+    const float shift = WhitePoint::CircadianWarmth(m_minuteOfDay, ambient) *
+                        warmth * WARMTH_STEP_K;
+    m_whitePoint = WhitePoint::FromKelvin(WhitePoint::DAYLIGHT_K - shift);
+    return true;
+}
+
+template <typename Geometry>
+uint32_t BasicPixels<Geometry>::GetEstimatedCurrentMa() const {
+    return (Geometry::TOTAL_LEDS * LED_IDLE_UA) / 1000 +
+           (m_frameChannelSum * LED_CHANNEL_MA) / 255;
+}
+
+template <typename Geometry>
+void BasicPixels<Geometry>::LimitPower() {
+    const uint32_t idleMa = (Geometry::TOTAL_LEDS * LED_IDLE_UA) / 1000;
+    const uint32_t channelMa = (m_frameChannelSum * LED_CHANNEL_MA) / 255;
+    const uint32_t availableMa =
+        m_powerBudgetMa > idleMa ? m_powerBudgetMa - idleMa : 0;
+    // the power scale that would make this frame use all of the budget
+    const uint32_t fitScale =
+        channelMa ? std::min<uint64_t>(
+                        (uint64_t)m_powerScale * availableMa / channelMa,
+                        PixelMath::UNITY)
+                  : PixelMath::UNITY;
+
+    if (fitScale < m_powerScale) {
+        // the frame got brighter than the budget allows for. It has already
+        // been drawn, so only the frames after it are drawn at the new
+        // scale, the whole frame by the same amount so that the colors stay
+        // the same and only the brightness gives way
+        ++m_powerClampCount;
+        m_powerScale = fitScale;
+    } else if (fitScale - m_powerScale >= POWER_SCALE_STEP ||
+               (fitScale == PixelMath::UNITY && m_powerScale != fitScale)) {
+        // brighten back up over a few frames, so that a frame on the edge of
+        // the budget doesn't flicker between the two
+        const uint32_t gap = fitScale - m_powerScale;
+        m_powerScale += gap >= 2 * POWER_SCALE_STEP ? gap / 2 : gap;
+    }
+}
+
+template <typename Geometry>
+void BasicPixels<Geometry>::SetPixelColor(const int pos, const RgbColor color) {
+    if (m_renderTarget) {
+        if (pos >= 0 && pos < Geometry::MATRIX_LEDS) {
+            (*m_renderTarget)[pos] = color;
         }
+        return;
     }
+    SetLED(pos, color);
 }
+
+template class BasicPixels<ActiveGeometry>;
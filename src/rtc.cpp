@@ -1,5 +1,18 @@
+#include <Wire.h>
 #include <dprint.hpp>
 #include <rtc.hpp>
+#if FCOS_ESP32_C3
+#include <esp_sntp.h>
+#elif FCOS_ESP8266
+#include <coredecls.h>  // settimeofday_cb()
+#include <sntp.h>
+
+// the ESP8266 core asks for the sync interval through this weak function
+static uint32_t s_ntpIntervalMs = ClockDiscipline::MIN_INTERVAL_S * 1000;
+uint32_t sntp_update_delay_MS_rfc_not_less_than_15000() {
+    return s_ntpIntervalMs;
+}
+#endif
 
 Rtc::Rtc(std::shared_ptr<Settings> settings) : m_settings(settings) {
     GetTimeFromRTC();
@@ -24,22 +37,57 @@ void Rtc::Update() {
         Initialize();
     }
 
-    if (m_receivedInterrupt) {
-        // happens once per second
-        m_receivedInterrupt = false;
-        m_uptime++;
-        GetTimeFromRTC();
-        // m_millisAtInterrupt = millis();
+    const uint32_t seconds = DrainTicks();
+    if (seconds > 0) {
+        // once per second, or more after the loop stalled
+        m_uptime += seconds;
+
+        // count the time in software, and only read it back from the RTC
+        // every so often, or when a tick went missing and it may be off
+        if (m_secondsUntilResync > 1 && seconds == 1) {
+            m_secondsUntilResync--;
+            m_time.AdvanceSeconds(seconds);
+        } else if (!GetTimeFromRTC()) {
+            m_time.AdvanceSeconds(seconds);  // try again on the next tick
+        }
+        CorrectDrift(seconds);
+        CheckDaylightSaving();
+
+        // right after an edge, so there's most of a second to set the RTC
+        // before the next one
+        CheckNTPTime();
     }
+}
 
-    CheckNTPTime();
+size_t Rtc::Millis() {
+    if (m_timeBase.GetEdges() == 0) {
+        return ((size_t)millis() - m_millisAtInterrupt) % 1000;
+    }
+    return m_timeBase.MicrosIntoSecond(micros()) / 1000;
 }
 
 void Rtc::SetTime(uint8_t hour, uint8_t minute, uint8_t second) {
     m_rtc.setTime(hour, minute, second);
+    m_time.hour = hour;  // in case it can't be read back
+    m_time.minute = minute;
+    m_time.second = second;
+    GetTimeFromRTC();
+}
+
+void Rtc::SetDateTime(const int64_t localEpoch) {
+    Pcf8563Time time;
+    time.SetEpoch(localEpoch);
+    m_rtc.setDate(time.day, time.weekday, time.month, time.year < 2000,
+                  time.year % 100);
+    m_rtc.setTime(time.hour, time.minute, time.second);
+    m_time = time;  // in case it can't be read back
     GetTimeFromRTC();
 }
 
+int64_t Rtc::Epoch() {
+    return m_time.Epoch() - m_timezone.GetOffset();
+}
+
 int Rtc::Conv24to12(int hour) {
     if (hour > 12) {
         hour -= 12;
@@ -51,28 +99,33 @@ int Rtc::Conv24to12(int hour) {
 
 void Rtc::SetClockToZero() {
     m_rtc.zeroClock();
+    m_time = Pcf8563Time();
     GetTimeFromRTC();
 }
 
-std::vector<String> Rtc::GetTimezoneNames() {
-    std::vector<String> names;
-    for (const auto& tz : m_timezones) {
-        names.push_back(tz.name);
+void Rtc::SetTimezone(const int index) {
+    const String name = Timezones::Name(index);
+    if (name.length() == 0) {
+        return;
     }
-    return names;
-}
+    (*m_settings)["timezone"] = name;
+    (*m_settings)["TIMEZONE"] = index;
 
-int Rtc::GetTimezoneNumFromName(const String& name) {
-    for (size_t i = 0; i < m_timezones.size(); i++) {
-        if (m_timezones[i].name == name) {
-            return i;
-        }
+    // once NTP has said what the time is, the clock moves to the new zone
+    const int64_t utc = Epoch();
+    m_timezone.Parse(Timezones::Rule(index).c_str());
+    if (m_discipline.GetSyncs() > 0) {
+        SetDateTime(m_timezone.ToLocal(utc));
     }
-    return 6;  // UTC 0; always return something valid
 }
 
 void Rtc::ForceNTPUpdate() {
-    m_uptimeForNextNTPUpdate = m_uptime;
+#if FCOS_ESP32_C3
+    sntp_restart();
+#elif FCOS_ESP8266
+    sntp_stop();
+    sntp_init();
+#endif
 }
 
 void Rtc::Initialize() {
@@ -104,131 +157,220 @@ void Rtc::Initialize() {
     }
 }
 
-void Rtc::GetTimeFromRTC() {
+bool Rtc::GetTimeFromRTC() {
     unsigned long msAtInterrupt = millis();
 
-    m_rtc.getDateTime();
-    if (m_rtc.getHour() < 24) {  // the RTC reports 33 initially
-        m_hour = m_rtc.getHour();
-        m_minute = m_rtc.getMinute();
-        if (m_second != m_rtc.getSecond()) {
-            m_millisAtInterrupt = msAtInterrupt;
-            m_second = m_rtc.getSecond();
-        }
+    Pcf8563Time time;
+    if (!ReadTimeRegisters(time)) {
+        m_secondsUntilResync = 1;
+        return false;
+    }
+    if (m_time.second != time.second) {
+        m_millisAtInterrupt = msAtInterrupt;
     }
+    m_time = time;
+    m_secondsUntilResync = RESYNC_INTERVAL_S;
+    return true;
 }
 
-void Rtc::CheckNTPTime() {
-    if (WiFi.isConnected() && m_uptime > m_uptimeForNextNTPUpdate) {
-        if (GetLocalTime(&m_timeinfo, MAX_WAIT_FOR_NTP_MS)) {
-            m_uptimeForNextNTPUpdate = m_uptime + (180 * 60) + (rand() % 120);
-
-            int selectedTimezone =
-                GetTimezoneNumFromName((*m_settings)["timezone"]);
-            (*m_settings)["TIMEZONE"] = selectedTimezone;
-            auto local =
-                m_timezones[selectedTimezone].tz.toLocal(mktime(&m_timeinfo));
-            m_timeinfo = *localtime(&local);
-
-            SetTime(m_timeinfo.tm_hour, m_timeinfo.tm_min, m_timeinfo.tm_sec);
-
-            TDPRINT(this,
-                    "Got NTP time (%02d:%02d:%02d) (TZ: %s) next update in "
-                    "~3 hours @ %ds   \n",
-                    m_timeinfo.tm_hour, m_timeinfo.tm_min, m_timeinfo.tm_sec,
-                    m_timezones[selectedTimezone].name.c_str(),
-                    m_uptimeForNextNTPUpdate);
-        } else {
-            TDPRINT(this, "Failed to get time, retry in ~10s         \n");
-            m_uptimeForNextNTPUpdate = m_uptime + (8 + (rand() % 4));
+// reads all of the time registers in one transaction, so they can't roll
+// over part way through, and checks they hold a real time
+bool Rtc::ReadTimeRegisters(Pcf8563Time& time) {
+    const uint32_t start = micros();
+    uint8_t regs[Pcf8563Time::NUM_REGISTERS];
+    bool ok = false;
+
+    Wire.beginTransmission(I2C_ADDRESS);
+    Wire.write((uint8_t)Pcf8563Time::FIRST_REGISTER);
+    if (Wire.endTransmission(false) == 0 &&
+        Wire.requestFrom((uint8_t)I2C_ADDRESS,
+                         (uint8_t)Pcf8563Time::NUM_REGISTERS) ==
+            Pcf8563Time::NUM_REGISTERS) {
+        for (auto& reg : regs) {
+            reg = Wire.read();
         }
+        ok = Pcf8563Time::Decode(regs, time);  // the RTC reports 33h initially
     }
+
+    const uint32_t us = micros() - start;
+    m_i2cStats.reads++;
+    m_i2cStats.failures += ok ? 0 : 1;
+    m_i2cStats.totalUs += us;
+    m_i2cStats.maxUs = std::max(m_i2cStats.maxUs, us);
+    return ok;
 }
 
-bool Rtc::GetLocalTime(struct tm* info, uint32_t ms) {
-    uint32_t start = millis();
-    time_t now;
-    while ((millis() - start) <= ms) {
-        time(&now);
-        localtime_r(&now, info);
-        if (info->tm_year > (2016 - 1900)) {
-            return true;
-        }
-        delay(10);
+// feeds each interrupt since the last Update() to the time base, returning
+// the seconds that passed. A tick that never arrived still counts, the time
+// base spots the gap between the edges either side of it.
+uint32_t Rtc::DrainTicks() {
+    const uint32_t ticks = m_ticks.load(std::memory_order_acquire);
+    const uint32_t pending = ticks - m_drainedTicks;
+    if (pending == 0) {
+        return 0;
+    }
+    m_tickStats.coalesced += pending - 1;
+    m_tickStats.maxPending = std::max(m_tickStats.maxPending, pending);
+
+    // the ISR may be overwriting the oldest slot while this reads, so only
+    // the newer ones are used after a very long stall
+    const uint32_t usable = std::min(pending, (uint32_t)EDGE_RING_SIZE - 1);
+    const uint32_t edges = m_timeBase.GetEdges();
+    for (uint32_t tick = ticks - usable; tick < ticks; tick++) {
+        m_timeBase.OnEdge(m_edgeMicros[tick % EDGE_RING_SIZE]);
+    }
+    m_drainedTicks = ticks;
+    m_lastEdgeMicros = m_edgeMicros[(ticks - 1) % EDGE_RING_SIZE];
+
+    const uint32_t seconds = m_timeBase.GetEdges() - edges;
+    m_tickStats.missed += seconds > pending ? seconds - pending : 0;
+    return seconds;
+}
+
+// between syncs, steps the clock by a second whenever the drift measured
+// so far adds up to one. The RTC is set too, so a read back agrees.
+void Rtc::CorrectDrift(const uint32_t seconds) {
+    const int step = m_discipline.Tick(seconds);
+    if (step == 0 || !m_isInitialized) {
+        return;
+    }
+    // losing a second holds the one that's showing for another second
+    SetDateTime(m_time.Epoch() + step);
+}
+
+// the RTC keeps local time, so it's moved when daylight saving starts or
+// ends, rather than waiting for the next NTP sync. Until there's been one,
+// it isn't known which side of the transition the RTC is on.
+void Rtc::CheckDaylightSaving() {
+    const int64_t utc = Epoch();
+    if (m_discipline.GetSyncs() == 0 || utc < m_timezone.GetNextTransition()) {
+        return;
     }
-    return false;
+    SetDateTime(m_timezone.ToLocal(utc));
+    TDPRINT(this, "Daylight saving %s          \n",
+            m_timezone.IsDst() ? "started" : "ended");
 }
 
+// applies the time from the last NTP sync, if there is a new one. It's
+// extrapolated to the RTC edge that just happened and rounded to the nearest
+// second, as the RTC can't be set to part of one. How far off the RTC was
+// beforehand, less what it was left off by at the previous sync, is drift.
+void Rtc::CheckNTPTime() {
+    if (!m_receivedNTP.load(std::memory_order_acquire)) {
+        return;
+    }
+    m_receivedNTP.store(false, std::memory_order_relaxed);
+
+    const time_t local = m_timezone.ToLocal(m_ntpTime.tv_sec);
+
+    const int64_t edgeUs = (int64_t)local * ClockDiscipline::SECOND_US +
+                           m_ntpTime.tv_usec +
+                           (int32_t)(m_lastEdgeMicros - m_ntpMicros);
+    const int64_t offsetUs =
+        m_time.Epoch() * ClockDiscipline::SECOND_US - edgeUs;
+    m_discipline.OnSync(offsetUs, m_uptime - m_uptimeAtNTP);
+    m_uptimeAtNTP = m_uptime;
+
+    const int64_t rounded =
+        (edgeUs + ClockDiscipline::SECOND_US / 2) / ClockDiscipline::SECOND_US;
+    m_discipline.SetBaseline(rounded * ClockDiscipline::SECOND_US - edgeUs);
+    SetDateTime(rounded);
+
+    // takes effect from the sync after next, the SDK has already scheduled
+    // the next one
+    const uint32_t intervalMs = m_discipline.GetIntervalS() * 1000;
+#if FCOS_ESP32_C3
+    sntp_set_sync_interval(intervalMs);
+#elif FCOS_ESP8266
+    s_ntpIntervalMs = intervalMs;
+#endif
+
+    TDPRINT(this,
+            "Got NTP time (TZ: %s), RTC was %dms off, drift %.1fppm, next "
+            "update in ~%dm   \n",
+            (*m_settings)["timezone"].as<String>().c_str(),
+            (int)(offsetUs / 1000), m_discipline.GetDriftPpm(),
+            m_discipline.GetIntervalS() / 60);
+}
+
+// called from the SDK's task, not the main loop
+void Rtc::OnNTPSync(struct timeval* tv) {
+    m_ntpMicros = micros();
+    m_ntpTime = *tv;
+    m_receivedNTP.store(true, std::memory_order_release);
+}
+
+// the zones offered before the IANA ones, for clocks that were set up with
+// one of them
+static const struct {
+    const char* name;
+    const char* zone;
+} LEGACY_TIMEZONES[] = {
+    {"UTC +12 New Zealand Daylight Time (DST)", "Pacific/Auckland"},
+    {"UTC +10 Australia Eastern Time (DST)", "Australia/Sydney"},
+    {"UTC +8 Australia Western Time (DST)", "Australia/Perth"},
+    {"UTC +3 Moscow Standard Time (no DST)", "Europe/Moscow"},
+    {"UTC +2 (no DST)", "Etc/GMT-2"},
+    {"UTC +1 Central European Time (DST)", "Europe/Berlin"},
+    {"UTC 0 London (DST)", "Europe/London"},
+    {"UTC 0", "Etc/UTC"},
+    {"UTC -1 (no DST)", "Etc/GMT+1"},
+    {"UTC -2 (no DST)", "Etc/GMT+2"},
+    {"UTC -3 (no DST)", "Etc/GMT+3"},
+    {"UTC -4 Eastern Daylight Time (DST)", "America/New_York"},
+    {"UTC -5 Central Daylight Time (DST)", "America/Chicago"},
+    {"UTC -6 Mountain Daylight Time (DST)", "America/Denver"},
+    {"UTC -6 Arizona (no DST)", "America/Phoenix"},
+    {"UTC -7 Pacific Daylight Time (DST)", "America/Los_Angeles"},
+    {"UTC -8 Alaska Daylight Time (DST)", "America/Anchorage"},
+    {"UTC -10 Hawaii Standard Time (no DST)", "Pacific/Honolulu"},
+};
+
 void Rtc::SetupTimezones() {
-    TimeChangeRule nzDT = {"NZDT", week_t::First, Sun, Sep, 25, 780};
-    TimeChangeRule nzST = {"NZST", week_t::First, Sun, Apr, 3, 720};
-    TimeChangeRule aEDT = {"AEDT", week_t::First, Sun, Oct, 2, 660};
-    TimeChangeRule aEST = {"AEST", week_t::First, Sun, Apr, 3, 600};
-    TimeChangeRule aWDT = {"AWDT", week_t::First, Sun, Oct, 2, 540};
-    TimeChangeRule aWST = {"AWST", week_t::First, Sun, Apr, 3, 480};
-    TimeChangeRule msk = {"MSK", week_t::Last, Sun, Mar, 1, 180};
-    TimeChangeRule utcPlus2 = {"UTC+2", week_t::Last, Sun, Oct, 30, 120};
-    TimeChangeRule CEST = {"CEST", week_t::Last, Sun, Mar, 27, 120};
-    TimeChangeRule CET = {"CET ", week_t::Last, Sun, Oct, 30, 60};
-    TimeChangeRule BST = {"BST", week_t::Last, Sun, Mar, 1, 60};
-    TimeChangeRule GMT = {"GMT", week_t::Last, Sun, Oct, 2, 0};
-    TimeChangeRule utcRule = {"UTC", week_t::Last, Sun, Mar, 1, 0};
-    TimeChangeRule utcMinus1 = {"UTC-1", week_t::Last, Sun, Mar, 1, -60};
-    TimeChangeRule utcMinus2 = {"UTC-2", week_t::Last, Sun, Mar, 1, -120};
-    TimeChangeRule utcMinus3 = {"UTC-3", week_t::Last, Sun, Mar, 1, -180};
-    TimeChangeRule usEDT = {"EDT", week_t::Second, Sun, Mar, 12, -240};
-    TimeChangeRule usEST = {"EST", First, Sun, Nov, 6, -300};
-    TimeChangeRule usCDT = {"CDT", week_t::Second, Sun, Mar, 12, -300};
-    TimeChangeRule usCST = {"CST", week_t::First, Sun, Nov, 6, -360};
-    TimeChangeRule usMDT = {"MDT", week_t::Second, Sun, Mar, 12, -360};
-    TimeChangeRule usMST = {"MST", week_t::First, Sun, Nov, 6, -420};
-    TimeChangeRule usPDT = {"PDT", week_t::Second, Sun, Mar, 12, -420};
-    TimeChangeRule usPST = {"PST", week_t::First, Sun, Nov, 6, -480};
-    TimeChangeRule usAKDT = {"AKDT", week_t::Second, Sun, Mar, 12, -480};
-    TimeChangeRule usAKST = {"AKST", week_t::First, Sun, Nov, 6, -540};
-    TimeChangeRule usHST = {"HST", week_t::First, Sun, Nov, 6, -600};
-
-    m_timezones.push_back(
-        {"UTC +12 New Zealand Daylight Time (DST)", {nzST, nzDT}});
-    m_timezones.push_back(
-        {"UTC +10 Australia Eastern Time (DST)", {aEDT, aEST}});
-    m_timezones.push_back(
-        {"UTC +8 Australia Western Time (DST)", {aWDT, aWST}});
-    m_timezones.push_back({"UTC +3 Moscow Standard Time (no DST)", {msk}});
-    m_timezones.push_back({"UTC +2 (no DST)", {utcPlus2}});
-    m_timezones.push_back({"UTC +1 Central European Time (DST)", {CEST, CET}});
-    m_timezones.push_back({"UTC 0 London (DST)", {BST, GMT}});
-    m_timezones.push_back({"UTC 0", {utcRule}});
-    m_timezones.push_back({"UTC -1 (no DST)", {utcMinus1}});
-    m_timezones.push_back({"UTC -2 (no DST)", {utcMinus2}});
-    m_timezones.push_back({"UTC -3 (no DST)", {utcMinus3}});
-    m_timezones.push_back(
-        {"UTC -4 Eastern Daylight Time (DST)", {usEDT, usEST}});
-    m_timezones.push_back(
-        {"UTC -5 Central Daylight Time (DST)", {usCDT, usCST}});
-    m_timezones.push_back(
-        {"UTC -6 Mountain Daylight Time (DST)", {usMDT, usMST}});
-    m_timezones.push_back({"UTC -6 Arizona (no DST)", {usMST}});
-    m_timezones.push_back(
-        {"UTC -7 Pacific Daylight Time (DST)", {usPDT, usPST}});
-    m_timezones.push_back(
-        {"UTC -8 Alaska Daylight Time (DST)", {usAKDT, usAKST}});
-    m_timezones.push_back({"UTC -10 Hawaii Standard Time (no DST)", {usHST}});
-
-    if (!(*m_settings).containsKey("TIMEZONE")) {
-        (*m_settings)["TIMEZONE"] = GetTimezoneNumFromName("UTC 0");
+    String name = (*m_settings).containsKey("timezone")
+                      ? (*m_settings)["timezone"].as<String>()
+                      : String("Etc/UTC");
+    for (const auto& legacy : LEGACY_TIMEZONES) {
+        if (name == legacy.name) {
+            name = legacy.zone;
+        }
     }
+    const int index = Timezones::Find(name);
+    SetTimezone(index >= 0 ? index : Timezones::Find("Etc/UTC"));
+
+#if FCOS_ESP32_C3
+    sntp_set_time_sync_notification_cb(OnNTPSync);
+    sntp_set_sync_interval(m_discipline.GetIntervalS() * 1000);
+#elif FCOS_ESP8266
+    settimeofday_cb([](bool fromSntp) {
+        if (fromSntp) {
+            struct timeval tv;
+            gettimeofday(&tv, nullptr);
+            OnNTPSync(&tv);
+        }
+    });
+#endif
     configTime(0, 0, "pool.ntp.org", "time.nist.gov");
 }
 
 void Rtc::AttachInterrupt() {
+    LoopEvents();  // created before the ISR can use it
     pinMode(PIN_RTC_INTERRUPT, INPUT_PULLUP);
     attachInterrupt(digitalPinToInterrupt(PIN_RTC_INTERRUPT), InterruptISR,
                     FALLING);
 }
 
-bool Rtc::m_receivedInterrupt = false;
+std::atomic<bool> Rtc::m_receivedNTP{false};
+struct timeval Rtc::m_ntpTime;
+uint32_t Rtc::m_ntpMicros = 0;
+std::atomic<uint32_t> Rtc::m_ticks{0};
+volatile uint32_t Rtc::m_edgeMicros[EDGE_RING_SIZE];
 
 void Rtc::InterruptISR() {
-    m_receivedInterrupt = true;
+    // the time of the edge, rather than when the loop gets to it. This is the
+    // only writer, so a plain load and store is enough (no read-modify-write)
+    const uint32_t tick = m_ticks.load(std::memory_order_relaxed);
+    m_edgeMicros[tick % EDGE_RING_SIZE] = micros();
+    m_ticks.store(tick + 1, std::memory_order_release);
+    LoopEvents().SetFromISR(EVENT_RTC_TICK);
 }
@@ -1,6 +1,8 @@
 #include <set_time.hpp>
 
-SetTime::SetTime(std::shared_ptr<Rtc> rtc) : m_rtc(rtc) {}
+SetTime::SetTime(std::shared_ptr<Rtc> rtc) : m_rtc(rtc) {
+    m_name = "TIME";
+}
 
 void SetTime::Activate() {
     m_mode = SET_HOUR;
@@ -0,0 +1,223 @@
+// Generated by gen_timezones.py -- don't edit
+#include <timezones.hpp>
+
+const int Timezones::COUNT = 553;
+
+const char Timezones::NAMES[] PROGMEM =
+    "Africa/Abidjan /Accra /Addis_Ababa /Algiers /Asmara /Asmera /Bamako "
+    "/Bangui /Banjul /Bissau /Blantyre /Brazzaville /Bujumbura /Cairo "
+    "/Casablanca /Ceuta /Conakry /Dakar /Dar_es_Salaam /Djibouti /Douala "
+    "/El_Aaiun /Freetown /Gaborone /Harare /Johannesburg /Juba /Kampala "
+    "/Khartoum /Kigali /Kinshasa /Lagos /Libreville /Lome /Luanda /Lubumbashi "
+    "/Lusaka /Malabo /Maputo /Maseru /Mbabane /Mogadishu /Monrovia /Nairobi "
+    "/Ndjamena /Niamey /Nouakchott /Ouagadougou /Porto-Novo /Sao_Tome "
+    "/Timbuktu /Tripoli /Tunis /Windhoek America/Adak /Anchorage /Anguilla "
+    "/Antigua /Araguaina /Argentina/Buenos_Aires /Argentina/Catamarca "
+    "/Argentina/ComodRivadavia /Argentina/Cordoba /Argentina/Jujuy "
+    "/Argentina/La_Rioja /Argentina/Mendoza /Argentina/Rio_Gallegos "
+    "/Argentina/Salta /Argentina/San_Juan /Argentina/San_Luis "
+    "/Argentina/Tucuman /Argentina/Ushuaia /Aruba /Asuncion /Atikokan /Atka "
+    "/Bahia /Bahia_Banderas /Barbados /Belem /Belize /Blanc-Sablon /Boa_Vista "
+    "/Bogota /Boise /Buenos_Aires /Cambridge_Bay /Campo_Grande /Cancun "
+    "/Caracas /Catamarca /Cayenne /Cayman /Chicago /Chihuahua /Ciudad_Juarez "
+    "/Coral_Harbour /Cordoba /Costa_Rica /Coyhaique /Creston /Cuiaba /Curacao "
+    "/Danmarkshavn /Dawson /Dawson_Creek /Denver /Detroit /Dominica /Edmonton "
+    "/Eirunepe /El_Salvador /Ensenada /Fort_Nelson /Fort_Wayne /Fortaleza "
+    "/Glace_Bay /Godthab /Goose_Bay /Grand_Turk /Grenada /Guadeloupe "
+    "/Guatemala /Guayaquil /Guyana /Halifax /Havana /Hermosillo "
+    "/Indiana/Indianapolis /Indiana/Knox /Indiana/Marengo /Indiana/Petersburg "
+    "/Indiana/Tell_City /Indiana/Vevay /Indiana/Vincennes /Indiana/Winamac "
+    "/Indianapolis /Inuvik /Iqaluit /Jamaica /Jujuy /Juneau "
+    "/Kentucky/Louisville /Kentucky/Monticello /Knox_IN /Kralendijk /La_Paz "
+    "/Lima /Los_Angeles /Louisville /Lower_Princes /Maceio /Managua /Manaus "
+    "/Marigot /Martinique /Matamoros /Mazatlan /Mendoza /Menominee /Merida "
+    "/Metlakatla /Mexico_City /Miquelon /Moncton /Monterrey /Montevideo "
+    "/Montreal /Montserrat /Nassau /New_York /Nipigon /Nome /Noronha "
+    "/North_Dakota/Beulah /North_Dakota/Center /North_Dakota/New_Salem /Nuuk "
+    "/Ojinaga /Panama /Pangnirtung /Paramaribo /Phoenix /Port-au-Prince "
+    "/Port_of_Spain /Porto_Acre /Porto_Velho /Puerto_Rico /Punta_Arenas "
+    "/Rainy_River /Rankin_Inlet /Recife /Regina /Resolute /Rio_Branco "
+    "/Rosario /Santa_Isabel /Santarem /Santiago /Santo_Domingo /Sao_Paulo "
+    "/Scoresbysund /Shiprock /Sitka /St_Barthelemy /St_Johns /St_Kitts "
+    "/St_Lucia /St_Thomas /St_Vincent /Swift_Current /Tegucigalpa /Thule "
+    "/Thunder_Bay /Tijuana /Toronto /Tortola /Vancouver /Virgin /Whitehorse "
+    "/Winnipeg /Yakutat /Yellowknife Antarctica/Casey /Davis /DumontDUrville "
+    "/Macquarie /Mawson /McMurdo /Palmer /Rothera /South_Pole /Syowa /Troll "
+    "/Vostok Arctic/Longyearbyen Asia/Aden /Almaty /Amman /Anadyr /Aqtau "
+    "/Aqtobe /Ashgabat /Ashkhabad /Atyrau /Baghdad /Bahrain /Baku /Bangkok "
+    "/Barnaul /Beirut /Bishkek /Brunei /Calcutta /Chita /Choibalsan "
+    "/Chongqing /Chungking /Colombo /Dacca /Damascus /Dhaka /Dili /Dubai "
+    "/Dushanbe /Famagusta /Gaza /Harbin /Hebron /Ho_Chi_Minh /Hong_Kong /Hovd "
+    "/Irkutsk /Istanbul /Jakarta /Jayapura /Jerusalem /Kabul /Kamchatka "
+    "/Karachi /Kashgar /Kathmandu /Katmandu /Khandyga /Kolkata /Krasnoyarsk "
+    "/Kuala_Lumpur /Kuching /Kuwait /Macao /Macau /Magadan /Makassar /Manila "
+    "/Muscat /Nicosia /Novokuznetsk /Novosibirsk /Omsk /Oral /Phnom_Penh "
+    "/Pontianak /Pyongyang /Qatar /Qostanay /Qyzylorda /Rangoon /Riyadh "
+    "/Saigon /Sakhalin /Samarkand /Seoul /Shanghai /Singapore /Srednekolymsk "
+    "/Taipei /Tashkent /Tbilisi /Tehran /Tel_Aviv /Thimbu /Thimphu /Tokyo "
+    "/Tomsk /Ujung_Pandang /Ulaanbaatar /Ulan_Bator /Urumqi /Ust-Nera "
+    "/Vientiane /Vladivostok /Yakutsk /Yangon /Yekaterinburg /Yerevan "
+    "Atlantic/Azores /Bermuda /Canary /Cape_Verde /Faeroe /Faroe /Jan_Mayen "
+    "/Madeira /Reykjavik /South_Georgia /St_Helena /Stanley Australia/ACT "
+    "/Adelaide /Brisbane /Broken_Hill /Canberra /Currie /Darwin /Eucla "
+    "/Hobart /LHI /Lindeman /Lord_Howe /Melbourne /NSW /North /Perth "
+    "/Queensland /South /Sydney /Tasmania /Victoria /West /Yancowinna "
+    "Brazil/Acre /DeNoronha /East /West Canada/Atlantic /Central /Eastern "
+    "/Mountain /Newfoundland /Pacific /Saskatchewan /Yukon Chile/Continental "
+    "/EasterIsland Etc/GMT /GMT+0 /GMT+1 /GMT+10 /GMT+11 /GMT+12 /GMT+2 "
+    "/GMT+3 /GMT+4 /GMT+5 /GMT+6 /GMT+7 /GMT+8 /GMT+9 /GMT-0 /GMT-1 /GMT-10 "
+    "/GMT-11 /GMT-12 /GMT-13 /GMT-14 /GMT-2 /GMT-3 /GMT-4 /GMT-5 /GMT-6 "
+    "/GMT-7 /GMT-8 /GMT-9 /GMT0 /Greenwich /UCT /UTC /Universal /Zulu "
+    "Europe/Amsterdam /Andorra /Astrakhan /Athens /Belfast /Belgrade /Berlin "
+    "/Bratislava /Brussels /Bucharest /Budapest /Busingen /Chisinau "
+    "/Copenhagen /Dublin /Gibraltar /Guernsey /Helsinki /Isle_of_Man "
+    "/Istanbul /Jersey /Kaliningrad /Kiev /Kirov /Kyiv /Lisbon /Ljubljana "
+    "/London /Luxembourg /Madrid /Malta /Mariehamn /Minsk /Monaco /Moscow "
+    "/Nicosia /Oslo /Paris /Podgorica /Prague /Riga /Rome /Samara /San_Marino "
+    "/Sarajevo /Saratov /Simferopol /Skopje /Sofia /Stockholm /Tallinn "
+    "/Tirane /Tiraspol /Ulyanovsk /Uzhgorod /Vaduz /Vatican /Vienna /Vilnius "
+    "/Volgograd /Warsaw /Zagreb /Zaporozhye /Zurich Indian/Antananarivo "
+    "/Chagos /Christmas /Cocos /Comoro /Kerguelen /Mahe /Maldives /Mauritius "
+    "/Mayotte /Reunion Mexico/BajaNorte /BajaSur /General Pacific/Apia "
+    "/Auckland /Bougainville /Chatham /Chuuk /Easter /Efate /Enderbury "
+    "/Fakaofo /Fiji /Funafuti /Galapagos /Gambier /Guadalcanal /Guam "
+    "/Honolulu /Johnston /Kanton /Kiritimati /Kosrae /Kwajalein /Majuro "
+    "/Marquesas /Midway /Nauru /Niue /Norfolk /Noumea /Pago_Pago /Palau "
+    "/Pitcairn /Pohnpei /Ponape /Port_Moresby /Rarotonga /Saipan /Samoa "
+    "/Tahiti /Tarawa /Tongatapu /Truk /Wake /Wallis /Yap US/Alaska /Aleutian "
+    "/Arizona /Central /East-Indiana /Eastern /Hawaii /Indiana-Starke "
+    "/Michigan /Mountain /Pacific /Samoa";
+
+const char Timezones::RULES[] PROGMEM =
+    "<+00>0<+02>-2,M3.5.0/1,M10.5.0/3\0"
+    "<+01>-1\0"
+    "<+02>-2\0"
+    "<+0330>-3:30\0"
+    "<+03>-3\0"
+    "<+0430>-4:30\0"
+    "<+04>-4\0"
+    "<+0530>-5:30\0"
+    "<+0545>-5:45\0"
+    "<+05>-5\0"
+    "<+0630>-6:30\0"
+    "<+06>-6\0"
+    "<+07>-7\0"
+    "<+0845>-8:45\0"
+    "<+08>-8\0"
+    "<+09>-9\0"
+    "<+1030>-10:30<+11>-11,M10.1.0,M4.1.0\0"
+    "<+10>-10\0"
+    "<+11>-11\0"
+    "<+11>-11<+12>,M10.1.0,M4.1.0/3\0"
+    "<+1245>-12:45<+1345>,M9.5.0/2:45,M4.1.0/3:45\0"
+    "<+12>-12\0"
+    "<+13>-13\0"
+    "<+14>-14\0"
+    "<-01>1\0"
+    "<-01>1<+00>,M3.5.0/0,M10.5.0/1\0"
+    "<-02>2\0"
+    "<-02>2<-01>,M3.5.0/-1,M10.5.0/0\0"
+    "<-03>3\0"
+    "<-03>3<-02>,M3.2.0,M11.1.0\0"
+    "<-04>4\0"
+    "<-04>4<-03>,M9.1.6/24,M4.1.6/24\0"
+    "<-05>5\0"
+    "<-06>6\0"
+    "<-06>6<-05>,M9.1.6/22,M4.1.6/22\0"
+    "<-07>7\0"
+    "<-08>8\0"
+    "<-0930>9:30\0"
+    "<-09>9\0"
+    "<-10>10\0"
+    "<-11>11\0"
+    "<-12>12\0"
+    "ACST-9:30\0"
+    "ACST-9:30ACDT,M10.1.0,M4.1.0/3\0"
+    "AEST-10\0"
+    "AEST-10AEDT,M10.1.0,M4.1.0/3\0"
+    "AKST9AKDT,M3.2.0,M11.1.0\0"
+    "AST4\0"
+    "AST4ADT,M3.2.0,M11.1.0\0"
+    "AWST-8\0"
+    "CAT-2\0"
+    "CET-1\0"
+    "CET-1CEST,M3.5.0,M10.5.0/3\0"
+    "CST-8\0"
+    "CST5CDT,M3.2.0/0,M11.1.0/1\0"
+    "CST6\0"
+    "CST6CDT,M3.2.0,M11.1.0\0"
+    "ChST-10\0"
+    "EAT-3\0"
+    "EET-2\0"
+    "EET-2EEST,M3.4.4/50,M10.4.4/50\0"
+    "EET-2EEST,M3.5.0,M10.5.0/3\0"
+    "EET-2EEST,M3.5.0/0,M10.5.0/0\0"
+    "EET-2EEST,M3.5.0/3,M10.5.0/4\0"
+    "EET-2EEST,M4.5.5/0,M10.5.4/24\0"
+    "EST5\0"
+    "EST5EDT,M3.2.0,M11.1.0\0"
+    "GMT0\0"
+    "GMT0BST,M3.5.0/1,M10.5.0\0"
+    "HKT-8\0"
+    "HST10\0"
+    "HST10HDT,M3.2.0,M11.1.0\0"
+    "IST-1GMT0,M10.5.0,M3.5.0/1\0"
+    "IST-2IDT,M3.4.4/26,M10.5.0\0"
+    "IST-5:30\0"
+    "JST-9\0"
+    "KST-9\0"
+    "MSK-3\0"
+    "MST7\0"
+    "MST7MDT,M3.2.0,M11.1.0\0"
+    "NST3:30NDT,M3.2.0,M11.1.0\0"
+    "NZST-12NZDT,M9.5.0,M4.1.0/3\0"
+    "PKT-5\0"
+    "PST-8\0"
+    "PST8PDT,M3.2.0,M11.1.0\0"
+    "SAST-2\0"
+    "SST11\0"
+    "UTC0\0"
+    "WAT-1\0"
+    "WET0WEST,M3.5.0/1,M10.5.0\0"
+    "WIB-7\0"
+    "WIT-9\0"
+    "WITA-8\0"
+    ;
+
+const uint8_t Timezones::ZONE_RULES[] PROGMEM = {
+    67, 67, 58, 51, 58, 58, 67, 88, 67, 67, 50, 88, 50, 64, 1, 52,
+    67, 67, 58, 58, 88, 1, 67, 50, 50, 85, 50, 58, 50, 50, 88, 88,
+    88, 67, 88, 50, 50, 88, 50, 85, 85, 58, 67, 58, 88, 88, 67, 67,
+    88, 67, 67, 59, 51, 50, 71, 46, 47, 47, 28, 28, 28, 28, 28, 28,
+    28, 28, 28, 28, 28, 28, 28, 28, 47, 28, 65, 71, 28, 55, 47, 28,
+    55, 47, 30, 32, 79, 28, 79, 30, 65, 30, 28, 28, 65, 56, 55, 79,
+    65, 28, 55, 28, 78, 30, 47, 67, 78, 78, 79, 66, 47, 79, 32, 55,
+    84, 78, 66, 28, 48, 27, 48, 66, 47, 47, 55, 32, 30, 48, 54, 78,
+    66, 56, 66, 66, 56, 66, 66, 66, 66, 79, 66, 65, 28, 46, 66, 66,
+    56, 47, 30, 32, 84, 66, 47, 28, 55, 30, 47, 47, 56, 78, 28, 56,
+    55, 46, 55, 29, 48, 55, 28, 66, 47, 66, 66, 66, 46, 26, 56, 56,
+    56, 27, 56, 65, 66, 28, 78, 66, 47, 32, 30, 47, 28, 56, 56, 28,
+    55, 56, 32, 28, 84, 28, 31, 47, 28, 27, 79, 46, 47, 80, 47, 47,
+    47, 47, 55, 55, 48, 66, 84, 66, 47, 84, 47, 78, 56, 46, 79, 14,
+    12, 17, 45, 9, 81, 28, 28, 81, 4, 0, 9, 52, 4, 9, 4, 21,
+    9, 9, 9, 9, 9, 4, 4, 6, 12, 12, 62, 11, 14, 74, 15, 14,
+    53, 53, 7, 11, 4, 11, 15, 6, 9, 63, 60, 53, 60, 12, 69, 12,
+    14, 4, 90, 91, 73, 5, 21, 82, 11, 8, 8, 15, 74, 12, 14, 14,
+    4, 53, 53, 18, 92, 83, 6, 63, 12, 12, 11, 9, 12, 90, 76, 4,
+    9, 9, 10, 4, 12, 18, 9, 76, 53, 14, 18, 53, 9, 6, 3, 73,
+    11, 11, 75, 12, 92, 14, 14, 11, 17, 12, 17, 15, 10, 9, 6, 25,
+    48, 89, 24, 89, 89, 52, 89, 67, 26, 67, 28, 45, 43, 44, 43, 45,
+    45, 42, 13, 45, 16, 44, 16, 45, 45, 42, 49, 44, 43, 45, 45, 45,
+    49, 43, 32, 26, 28, 30, 48, 56, 66, 79, 80, 84, 55, 78, 31, 34,
+    67, 67, 24, 39, 40, 41, 26, 28, 30, 32, 33, 35, 36, 38, 67, 1,
+    17, 18, 21, 22, 23, 2, 4, 6, 9, 11, 12, 14, 15, 67, 67, 87,
+    87, 87, 87, 52, 52, 6, 63, 68, 52, 52, 52, 52, 63, 52, 52, 61,
+    52, 72, 52, 68, 63, 68, 4, 68, 59, 63, 77, 63, 89, 52, 68, 52,
+    52, 52, 63, 4, 52, 77, 63, 52, 52, 52, 52, 63, 52, 6, 52, 52,
+    6, 77, 52, 63, 52, 63, 52, 61, 6, 63, 52, 52, 52, 63, 77, 52,
+    52, 63, 52, 58, 11, 12, 10, 58, 9, 6, 9, 6, 58, 6, 84, 78,
+    55, 22, 81, 18, 20, 17, 34, 18, 22, 22, 21, 21, 33, 38, 18, 57,
+    70, 70, 22, 23, 18, 21, 21, 37, 86, 21, 40, 19, 18, 86, 15, 36,
+    18, 18, 17, 39, 57, 86, 39, 21, 22, 17, 21, 21, 17, 46, 71, 78,
+    56, 66, 66, 70, 56, 66, 79, 84, 86,
+};
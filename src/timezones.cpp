@@ -0,0 +1,66 @@
+#include <string.h>
+#include <algorithm>
+#include <timezones.hpp>
+
+// unpacks each name in turn from |names| in PROGMEM, until |visit| returns
+// true, and returns the index it stopped at, or -1
+template <typename Visit>
+static int ForEachName(PGM_P names, const int count, Visit visit) {
+    char name[Timezones::MAX_NAME_LENGTH + 1];
+    size_t regionLength = 0;
+    for (int i = 0; i < count; ++i) {
+        size_t length = 0;
+        for (char c = pgm_read_byte(names); c != ' ' && c != '\0';
+             c = pgm_read_byte(names + ++length)) {
+        }
+        size_t start = 0;
+        if (pgm_read_byte(names) == '/') {
+            start = regionLength;  // still at the front of |name|
+        }
+        const size_t copied = std::min(length, sizeof(name) - start - 1);
+        memcpy_P(name + start, names, copied);
+        name[start + copied] = '\0';
+        if (start == 0) {
+            regionLength = strcspn(name, "/");
+        }
+        if (visit(name)) {
+            return i;
+        }
+        names += length + 1;
+    }
+    return -1;
+}
+
+String Timezones::Name(const int index) {
+    String found;
+    int i = 0;
+    ForEachName(NAMES, COUNT, [&](const char* name) {
+        if (i++ == index) {
+            found = name;
+            return true;
+        }
+        return false;
+    });
+    return found;
+}
+
+int Timezones::Find(const String& name) {
+    return ForEachName(NAMES, COUNT,
+                       [&](const char* candidate) { return name == candidate; });
+}
+
+String Timezones::Rule(const int index) {
+    if (index < 0 || index >= COUNT) {
+        return "UTC0";
+    }
+    PGM_P rule = RULES;
+    for (int i = 0; i < pgm_read_byte(&ZONE_RULES[index]); ++i) {
+        rule += strlen_P(rule) + 1;
+    }
+    char copy[MAX_RULE_LENGTH + 1];
+    if (strlen_P(rule) >= sizeof(copy)) {
+        return "UTC0";
+    }
+    strcpy_P(copy, rule);
+    return copy;
+}
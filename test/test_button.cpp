@@ -189,4 +189,21 @@ TEST_F(ButtonFx, AreLongPressEventsSent) {
     delay(btn.config.longPressTime + 10);
     btn.Update();
     EXPECT_TRUE(receivedLongPressEvent);  // Long press should be sent again
-}
\ No newline at end of file
+}
+
+TEST_F(ButtonFx, KnowsWhenItsNextTimedEventIsDue) {
+    EXPECT_EQ(btn.GetMsUntilTimedEvent(), (size_t)EventFlags::FOREVER);
+
+    // debouncing, then waiting to repeat
+    UpdatePinState(LOW);
+    EXPECT_GT(btn.GetMsUntilTimedEvent(), btn.config.debounceTime - 5);
+    EXPECT_LE(btn.GetMsUntilTimedEvent(), btn.config.debounceTime);
+    delay(btn.config.debounceTime + 1);
+    btn.Update();
+    EXPECT_GT(btn.GetMsUntilTimedEvent(),
+              btn.config.beforeRepeat - btn.config.debounceTime - 10);
+    EXPECT_LE(btn.GetMsUntilTimedEvent(), btn.config.beforeRepeat);
+
+    delay(btn.config.beforeRepeat + 1);
+    EXPECT_EQ(btn.GetMsUntilTimedEvent(), 0u);
+}
@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+
+#include <clock_discipline.hpp>  // the unit of code being tested
+
+///// Test Fixture (Fx), contains SetUp, TearDown, and shared variables ///////
+class ClockDisciplineFx : public ::testing::Test {
+  protected:
+    ClockDiscipline discipline;
+
+    // Helper functions for tests to use, to reduce code duplication
+
+    // runs a clock that gains |ppm| for |seconds| with the corrections from
+    // Tick() applied, and returns how far ahead it ended up, in us
+    int64_t Run(const float ppm, const uint32_t seconds) {
+        double aheadUs = 0;
+        for (uint32_t i = 0; i < seconds; ++i) {
+            aheadUs += ppm;
+            aheadUs += discipline.Tick(1) * (double)ClockDiscipline::SECOND_US;
+        }
+        return aheadUs;
+    }
+};
+
+///// Individual tests (all are member functions of the fixture) //////////////
+TEST_F(ClockDisciplineFx, MeasuresDriftBetweenSyncs) {
+    discipline.OnSync(0, 0);
+    const int64_t ahead = Run(20, 3600);  // 20ppm fast
+    EXPECT_NEAR(ahead, 72000, 1);
+    discipline.OnSync(ahead, 3600);
+    EXPECT_NEAR(discipline.GetDriftPpm(), 20, 0.01);
+}
+
+TEST_F(ClockDisciplineFx, CorrectsInWholeSeconds) {
+    discipline.OnSync(0, 0);
+    discipline.OnSync(72000, 3600);  // 20ppm fast
+
+    // after a day, the clock has lost the 1.7s it gained, to the nearest second
+    const int64_t ahead = Run(20, 24 * 3600);
+    EXPECT_LE(std::abs(ahead), ClockDiscipline::SECOND_US / 2);
+}
+
+TEST_F(ClockDisciplineFx, BackOffWhenTheDriftIsKnown) {
+    discipline.OnSync(0, 0);
+    EXPECT_EQ(discipline.GetIntervalS(), ClockDiscipline::MIN_INTERVAL_S);
+
+    // the first measurement is 72ms off, the rest are corrected
+    for (int i = 0; i < 6; ++i) {
+        const uint32_t interval = discipline.GetIntervalS();
+        discipline.OnSync(Run(20, interval), interval);
+    }
+    EXPECT_EQ(discipline.GetIntervalS(), ClockDiscipline::MAX_INTERVAL_S);
+    EXPECT_NEAR(discipline.GetDriftPpm(), 20, 0.5);
+}
+
+TEST_F(ClockDisciplineFx, BaselineIsNotDrift) {
+    // the RTC could only be set to the nearest second, 300ms ahead
+    discipline.OnSync(0, 0);
+    discipline.SetBaseline(300000);
+    discipline.OnSync(300000, 3600);
+    EXPECT_EQ(discipline.GetDriftPpm(), 0);
+}
+
+TEST_F(ClockDisciplineFx, IgnoresSyncsTooCloseTogether) {
+    discipline.OnSync(0, 0);
+    discipline.OnSync(100000, 60);
+    EXPECT_EQ(discipline.GetDriftPpm(), 0);
+    EXPECT_EQ(discipline.GetSyncs(), 2u);
+}
+
+TEST_F(ClockDisciplineFx, TimeSetByHandIsNotDrift) {
+    discipline.OnSync(0, 0);
+    discipline.OnSync(-5LL * 60 * ClockDiscipline::SECOND_US, 3600);
+    EXPECT_EQ(discipline.GetDriftPpm(), 0);
+    EXPECT_EQ(discipline.GetIntervalS(), ClockDiscipline::MIN_INTERVAL_S);
+}
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include <clock_face.hpp>  // the unit of code being tested
+
+///// Test Fixture (Fx), contains SetUp, TearDown, and shared variables ///////
+class ClockFaceFx : public ::testing::Test {
+  protected:
+    ClockFace face;
+    // the default FC2 face: a fixed color, the time and the breathing colon
+    const ClockFace::Motion STILL{false, false, false, true};
+
+    // Helper functions for tests to use, to reduce code duplication
+
+    // draws a frame |ms| into the day, as the Clock does every frame
+    float Frame(const uint32_t ms) {
+        return face.UpdateBreath((ms / 1000) % 60, ms % 1000, ms);
+    }
+};
+
+///// Individual tests (all are member functions of the fixture) //////////////
+TEST_F(ClockFaceFx, BreathStartsOnOddSecondsAndFadesUpAndDown) {
+    EXPECT_LT(Frame(0), 0.0f);
+    EXPECT_LT(Frame(999), 0.0f);
+    EXPECT_FLOAT_EQ(Frame(1000), 0.0f);
+    EXPECT_TRUE(face.IsBreathing());
+    EXPECT_NEAR(Frame(1000 + ClockFace::BREATH_MS / 2), 0.5f, 0.001f);
+    EXPECT_TRUE(face.IsBreathing());
+}
+
+TEST_F(ClockFaceFx, BreathEndsBeforeTheNextOddSecond) {
+    Frame(1000);
+    // a frame late in the even second ends it, even before BREATH_MS
+    Frame(2901);
+    EXPECT_FALSE(face.IsBreathing());
+    EXPECT_LT(Frame(2950), 0.0f);
+    Frame(3000);
+    EXPECT_TRUE(face.IsBreathing());
+}
+
+TEST_F(ClockFaceFx, StaticBetweenBreathsUntilTheTick) {
+    // the Clock draws the frame for a tick, then asks
+    Frame(0);
+    EXPECT_TRUE(face.IsStaticUntilNextTick(STILL));
+
+    Frame(1000);
+    for (uint32_t ms = 1033; ms < 2900; ms += 33) {
+        Frame(ms);
+        EXPECT_FALSE(face.IsStaticUntilNextTick(STILL)) << ms;
+    }
+
+    Frame(2933);
+    EXPECT_TRUE(face.IsStaticUntilNextTick(STILL));
+}
+
+TEST_F(ClockFaceFx, HiddenColonDoesNotKeepItAwake) {
+    // in the dark, the FC2 doesn't draw the colon at all
+    Frame(1000);
+    EXPECT_TRUE(face.IsStaticUntilNextTick({false, false, false, false}));
+}
+
+TEST_F(ClockFaceFx, AnythingMovingKeepsItAwake) {
+    Frame(0);
+    EXPECT_FALSE(face.IsStaticUntilNextTick({true, false, false, true}));
+    EXPECT_FALSE(face.IsStaticUntilNextTick({false, true, false, true}));
+    EXPECT_FALSE(face.IsStaticUntilNextTick({false, false, true, true}));
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <coroutine.hpp>  // the unit of code being tested
+
+// records each step it gets to, waiting in every way a flow can
+class Steps : public Coroutine {
+  public:
+    std::vector<int> steps;
+    bool isReady{false};
+    int count{0};
+
+  protected:
+    virtual void Run() override {
+        CO_BEGIN();
+        steps.push_back(1);
+        CO_YIELD();
+        steps.push_back(2);
+        CO_AWAIT(isReady);
+        steps.push_back(3);
+        CO_DELAY(100);
+        steps.push_back(4);
+        for (count = 0; count < 3; ++count) {
+            CO_YIELD();
+        }
+        steps.push_back(5);
+        CO_END();
+    }
+};
+
+///// Test Fixture (Fx), contains SetUp, TearDown, and shared variables ///////
+class CoroutineFx : public ::testing::Test {
+  protected:
+    Steps flow;
+    uint32_t nowMs{0xFFFFFFC0};  // close to millis() wrapping around
+};
+
+///// Individual tests (all are member functions of the fixture) //////////////
+TEST_F(CoroutineFx, RunsToTheFirstWait) {
+    EXPECT_TRUE(flow.Resume(nowMs));
+    EXPECT_EQ(flow.steps, (std::vector<int>{1}));
+    EXPECT_FALSE(flow.IsDone());
+
+    EXPECT_TRUE(flow.Resume(nowMs));
+    EXPECT_EQ(flow.steps, (std::vector<int>{1, 2}));
+}
+
+TEST_F(CoroutineFx, AwaitsUntilTheConditionIsTrue) {
+    flow.Resume(nowMs);
+    for (int i = 0; i < 5; ++i) {
+        flow.Resume(nowMs);
+    }
+    EXPECT_EQ(flow.steps, (std::vector<int>{1, 2}));
+
+    flow.isReady = true;
+    flow.Resume(nowMs);
+    EXPECT_EQ(flow.steps, (std::vector<int>{1, 2, 3}));
+}
+
+TEST_F(CoroutineFx, DelaysAcrossMillisWrapping) {
+    flow.isReady = true;
+    flow.Resume(nowMs);
+    flow.Resume(nowMs);  // starts the delay
+    flow.Resume(nowMs + 99);
+    EXPECT_EQ(flow.steps, (std::vector<int>{1, 2, 3}));
+
+    flow.Resume(nowMs + 100);
+    EXPECT_EQ(flow.steps, (std::vector<int>{1, 2, 3, 4}));
+}
+
+TEST_F(CoroutineFx, LoopsKeepTheirPlaceInMembers) {
+    flow.isReady = true;
+    flow.Resume(nowMs);
+    flow.Resume(nowMs);
+    flow.Resume(nowMs + 100);
+    EXPECT_EQ(flow.count, 0);
+    flow.Resume(nowMs + 100);
+    flow.Resume(nowMs + 100);
+    EXPECT_EQ(flow.count, 2);
+    EXPECT_FALSE(flow.IsDone());
+
+    EXPECT_FALSE(flow.Resume(nowMs + 100));
+    EXPECT_EQ(flow.steps, (std::vector<int>{1, 2, 3, 4, 5}));
+    EXPECT_TRUE(flow.IsDone());
+}
+
+TEST_F(CoroutineFx, DoesNothingOnceDone) {
+    flow.isReady = true;
+    while (flow.Resume(nowMs)) {
+        nowMs += 50;
+    }
+    const auto steps = flow.steps;
+    EXPECT_FALSE(flow.Resume(nowMs));
+    EXPECT_EQ(flow.steps, steps);
+}
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include <digit_morphs.hpp>  // the unit of code being tested
+
+///// Test Fixture (Fx), contains SetUp, TearDown, and shared variables ///////
+class DigitMorphsFx : public ::testing::Test {
+  protected:
+    using Morph = DigitMorphs::Morph;
+
+    const DigitMorphs::Table table = DigitMorphs::BuildTable();
+
+    // Helper functions for tests to use, to reduce code duplication
+    static const DigitMorphs::Glyph& Glyph(const int index) {
+        return DigitGlyphs::GLYPHS[index];
+    }
+
+    static int LitCells(const int index) {
+        int lit = 0;
+        for (const uint8_t cell : Glyph(index)) {
+            lit += cell != 0;
+        }
+        return lit;
+    }
+};
+
+///// Individual tests (all are member functions of the fixture) //////////////
+TEST_F(DigitMorphsFx, PathsGoFromTheOldGlyphToTheNewOne) {
+    for (int from = 0; from < 10; ++from) {
+        for (int to = 0; to < 10; ++to) {
+            const Morph& morph = table[from][to];
+            EXPECT_EQ(morph.fade, Morph::FADE_NONE);
+            for (int i = 0; i < morph.numPaths; ++i) {
+                const auto& cells = morph.paths[i].cells;
+                EXPECT_TRUE(Glyph(from)[cells[0]]) << from << "->" << to;
+                EXPECT_TRUE(Glyph(to)[cells[DigitMorphs::STEPS]])
+                    << from << "->" << to;
+                for (const uint8_t cell : cells) {
+                    EXPECT_LT(cell, DigitMorphs::CELLS);
+                }
+            }
+        }
+    }
+}
+
+TEST_F(DigitMorphsFx, EveryLitCellHasAPath) {
+    for (int from = 0; from < 10; ++from) {
+        for (int to = 0; to < 10; ++to) {
+            const Morph& morph = table[from][to];
+            EXPECT_EQ(morph.numPaths, std::max(LitCells(from), LitCells(to)));
+            for (int cell = 0; cell < DigitMorphs::CELLS; ++cell) {
+                bool isStart = false, isEnd = false;
+                for (int i = 0; i < morph.numPaths; ++i) {
+                    isStart |= morph.paths[i].cells[0] == cell;
+                    isEnd |= morph.paths[i].cells[DigitMorphs::STEPS] == cell;
+                }
+                EXPECT_EQ(isStart, Glyph(from)[cell] != 0)
+                    << from << "->" << to << " cell " << cell;
+                EXPECT_EQ(isEnd, Glyph(to)[cell] != 0)
+                    << from << "->" << to << " cell " << cell;
+            }
+        }
+    }
+}
+
+TEST_F(DigitMorphsFx, SpacesFadeInPlace) {
+    const int space = DigitGlyphs::SPACE;
+    for (int digit = 0; digit < 10; ++digit) {
+        const Morph& in = table[space][digit];
+        EXPECT_EQ(in.fade, Morph::FADE_IN);
+        EXPECT_EQ(in.numPaths, LitCells(digit));
+
+        const Morph& out = table[digit][space];
+        EXPECT_EQ(out.fade, Morph::FADE_OUT);
+        EXPECT_EQ(out.numPaths, LitCells(digit));
+
+        for (int i = 0; i < in.numPaths; ++i) {
+            const uint8_t cell = in.paths[i].cells[0];
+            EXPECT_TRUE(Glyph(digit)[cell]);
+            for (const uint8_t step : in.paths[i].cells) {
+                EXPECT_EQ(step, cell);
+            }
+        }
+    }
+    EXPECT_EQ(table[space][space].numPaths, 0);
+}
+
+TEST_F(DigitMorphsFx, DissolveRanksEveryCellOnce) {
+    const DigitMorphs::Ranks ranks = DigitMorphs::BuildDissolveRanks();
+    std::array<bool, DigitMorphs::CELLS> isUsed{};
+    for (const uint8_t rank : ranks) {
+        ASSERT_LT(rank, DigitMorphs::CELLS);
+        EXPECT_FALSE(isUsed[rank]);
+        isUsed[rank] = true;
+    }
+}
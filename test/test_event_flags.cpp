@@ -0,0 +1,45 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include <elapsed_time.hpp>
+#include <event_flags.hpp>  // the unit of code being tested
+
+///// Test Fixture (Fx), contains SetUp, TearDown, and shared variables ///////
+class EventFlagsFx : public ::testing::Test {
+  protected:
+    EventFlags flags;
+};
+
+///// Individual tests (all are member functions of the fixture) //////////////
+TEST_F(EventFlagsFx, TimesOutWhenNothingIsSet) {
+    ElapsedTime elapsed;
+    EXPECT_EQ(flags.Wait(EVENT_BUTTON, 50), 0u);
+    EXPECT_GE(elapsed.Ms(), 45u);
+}
+
+TEST_F(EventFlagsFx, ReturnsAndClearsOnlyTheBitsWaitedFor) {
+    flags.Set(EVENT_BUTTON | EVENT_RTC_TICK);
+    EXPECT_EQ(flags.Wait(EVENT_BUTTON, 0), (uint32_t)EVENT_BUTTON);
+    EXPECT_EQ(flags.Wait(EVENT_BUTTON, 0), 0u);
+    EXPECT_EQ(flags.Wait(EVENT_BUTTON | EVENT_RTC_TICK, 0),
+              (uint32_t)EVENT_RTC_TICK);
+}
+
+TEST_F(EventFlagsFx, WakesUpWhenAnotherThreadSets) {
+    ElapsedTime elapsed;
+    std::thread isr([&] {
+        delay(20);
+        flags.SetFromISR(EVENT_RTC_TICK);
+    });
+    EXPECT_EQ(flags.Wait(EVENT_RTC_TICK, EventFlags::FOREVER),
+              (uint32_t)EVENT_RTC_TICK);
+    EXPECT_LT(elapsed.Ms(), 1000u);
+    isr.join();
+}
+
+TEST_F(EventFlagsFx, ClearedBitsDontWakeIt) {
+    flags.Set(EVENT_RTC_TICK);
+    flags.Clear(EVENT_RTC_TICK);
+    EXPECT_EQ(flags.Wait(EVENT_RTC_TICK, 10), 0u);
+}
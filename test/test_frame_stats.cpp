@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+
+#include <frame_stats.hpp>  // the unit of code being tested
+
+///// Test Fixture (Fx), contains SetUp, TearDown, and shared variables ///////
+class FrameStatsFx : public ::testing::Test {
+  protected:
+    FrameStats stats;
+
+    virtual void SetUp() { stats.SetEnabled(true); }
+
+    // Helper functions for tests to use, to reduce code duplication
+    void Frame(const int written, const int changed, const uint32_t txUs) {
+        for (int i = 0; i < written; ++i) {
+            stats.CountWrite();
+        }
+        stats.EndFrame(changed, txUs);
+    }
+};
+
+///// Individual tests (all are member functions of the fixture) //////////////
+TEST_F(FrameStatsFx, CountsWritesAndChangesPerFrame) {
+    stats.SetBucket("CLOCK/Normal");
+    Frame(100, 10, 3000);
+    Frame(100, 0, 5000);
+
+    const auto& c = stats.GetBuckets().at("CLOCK/Normal");
+    EXPECT_EQ(c.frames, 2u);
+    EXPECT_EQ(c.written, 200u);
+    EXPECT_EQ(c.changed, 10u);
+    EXPECT_EQ(c.unchangedFrames, 1u);
+    EXPECT_EQ(c.transmitUs, 8000u);
+    EXPECT_EQ(c.maxTransmitUs, 5000u);
+}
+
+TEST_F(FrameStatsFx, FramesGoToTheBucketActiveWhenTheyEnd) {
+    stats.SetBucket("CLOCK/Normal");
+    stats.CountWrite();
+    stats.SetBucket("CLOCK/Snowfall");
+    Frame(2, 2, 1000);
+
+    EXPECT_EQ(stats.GetBuckets().count("CLOCK/Normal"), 0u);
+    EXPECT_EQ(stats.GetBuckets().at("CLOCK/Snowfall").written, 3u);
+}
+
+TEST_F(FrameStatsFx, ReportShowsAveragesPerFrame) {
+    stats.SetBucket("TIME");
+    Frame(90, 30, 2000);
+    Frame(110, 10, 4000);
+
+    const std::string report = stats.Report();
+    EXPECT_NE(report.find("TIME"), std::string::npos);
+    EXPECT_NE(report.find("written:100"), std::string::npos);
+    EXPECT_NE(report.find("changed:20"), std::string::npos);
+    EXPECT_NE(report.find("tx:3000us (max 4000us)"), std::string::npos);
+
+    stats.Reset();
+    EXPECT_TRUE(stats.Report().empty());
+}
+
+TEST_F(FrameStatsFx, CountsNothingWhileDisabled) {
+    stats.SetEnabled(false);
+    Frame(100, 10, 3000);
+    EXPECT_TRUE(stats.GetBuckets().empty());
+
+    // and doesn't carry writes over into the first frame once enabled
+    stats.SetEnabled(true);
+    Frame(5, 5, 3000);
+    EXPECT_EQ(stats.GetBuckets().at("?").written, 5u);
+}
@@ -0,0 +1,39 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include <geometry.hpp>  // the unit of code being tested
+
+///// Individual tests ////////////////////////////////////////////////////////
+TEST(Geometry, RowsAreInChainOrder) {
+    using G = MatrixGeometry<17, 11, 3>;
+    EXPECT_EQ(G::TOTAL_LEDS, 17 * 11 + 36);
+    for (int pos = 0; pos < G::TOTAL_LEDS; ++pos) {
+        EXPECT_EQ(G::CHAIN[pos], pos);
+    }
+}
+
+TEST(Geometry, SerpentineRowsRunBackwardsOnOddRows) {
+    using G = MatrixGeometry<32, 8, 0, 0, LAYOUT_ROWS_SERPENTINE>;
+    EXPECT_EQ(G::CHAIN[0], 0);
+    EXPECT_EQ(G::CHAIN[31], 31);
+    EXPECT_EQ(G::CHAIN[32], 63);  // x = 0, y = 1
+    EXPECT_EQ(G::CHAIN[63], 32);  // x = 31, y = 1
+}
+
+TEST(Geometry, SerpentineColumnsRunUpwardsOnOddColumns) {
+    using G = MatrixGeometry<64, 16, 0, 0, LAYOUT_COLUMNS_SERPENTINE>;
+    EXPECT_EQ(G::CHAIN[0], 0);              // x = 0, y = 0
+    EXPECT_EQ(G::CHAIN[64], 1);             // x = 0, y = 1
+    EXPECT_EQ(G::CHAIN[1], 31);             // x = 1, y = 0
+    EXPECT_EQ(G::CHAIN[15 * 64 + 1], 16);  // x = 1, y = 15
+}
+
+TEST(Geometry, EveryLEDIsMappedExactlyOnce) {
+    using G = MatrixGeometry<64, 16, 2, 4, LAYOUT_COLUMNS_SERPENTINE>;
+    auto chain = G::CHAIN;
+    std::sort(chain.begin(), chain.end());
+    for (int pos = 0; pos < G::TOTAL_LEDS; ++pos) {
+        EXPECT_EQ(chain[pos], pos);
+    }
+}
@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+
+#include <idle_detector.hpp>  // the unit of code being tested
+
+///// Test Fixture (Fx), contains SetUp, TearDown, and shared variables ///////
+class IdleDetectorFx : public ::testing::Test {
+  protected:
+    IdleDetector idle;
+
+    // Helper functions for tests to use, to reduce code duplication
+    void Frames(const int count, const uint32_t changed = 0) {
+        for (int i = 0; i < count; ++i) {
+            idle.OnFrame(changed, 5);
+        }
+    }
+};
+
+///// Individual tests (all are member functions of the fixture) //////////////
+TEST_F(IdleDetectorFx, IdleAfterASecondOfUnchangedFrames) {
+    Frames(IdleDetector::SETTLE_FRAMES);
+    EXPECT_FALSE(idle.IsIdle());  // the first frame set the brightness
+    Frames(1);
+    EXPECT_TRUE(idle.IsIdle());
+    EXPECT_TRUE(idle.CanSkipFrame());
+}
+
+TEST_F(IdleDetectorFx, DrawsTheTickAndAProbeAfterIt) {
+    Frames(IdleDetector::SETTLE_FRAMES + 1);
+    idle.OnTick();
+    EXPECT_FALSE(idle.CanSkipFrame());
+    Frames(1, 12);  // the digits changed, which is expected
+    EXPECT_TRUE(idle.IsIdle());
+    EXPECT_FALSE(idle.CanSkipFrame());  // the probe
+    Frames(1);
+    EXPECT_TRUE(idle.CanSkipFrame());
+}
+
+TEST_F(IdleDetectorFx, AnimationAfterATickWakesItUp) {
+    Frames(IdleDetector::SETTLE_FRAMES + 1);
+    idle.OnTick();
+    Frames(1, 12);
+    Frames(1, 3);  // the probe changed too, e.g. a digit morphing
+    EXPECT_FALSE(idle.IsIdle());
+}
+
+TEST_F(IdleDetectorFx, InputAndBrightnessWakeItUp) {
+    Frames(IdleDetector::SETTLE_FRAMES + 1);
+    idle.OnInput();
+    EXPECT_FALSE(idle.IsIdle());
+
+    Frames(IdleDetector::SETTLE_FRAMES);
+    EXPECT_TRUE(idle.IsIdle());
+    idle.OnFrame(0, 6);
+    EXPECT_FALSE(idle.IsIdle());
+}
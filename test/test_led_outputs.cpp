@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <geometry.hpp>
+#include <led_outputs.hpp>  // the unit of code being tested
+
+// stands in for a NeoPixelBus with NeoGrbFeature, recording what it sends
+struct MockColor {
+    uint8_t R, G, B;
+};
+
+struct MockBus {
+    int output;
+    std::vector<uint8_t> pixels;  // in wire order, G R B
+    std::vector<uint8_t> sent;
+    std::vector<int>* showOrder;
+
+    MockBus(int output, uint16_t numLEDs, std::vector<int>* showOrder)
+        : output(output), pixels(numLEDs * 3), showOrder(showOrder) {}
+
+    void Begin() {}
+
+    void Show() {
+        sent = pixels;
+        showOrder->push_back(output);
+    }
+
+    void SetPixelColor(uint16_t i, const MockColor& c) {
+        pixels[i * 3] = c.G;
+        pixels[i * 3 + 1] = c.R;
+        pixels[i * 3 + 2] = c.B;
+    }
+
+    MockColor GetPixelColor(uint16_t i) const {
+        return {pixels[i * 3 + 1], pixels[i * 3], pixels[i * 3 + 2]};
+    }
+
+    uint8_t* Pixels() { return pixels.data(); }
+
+    size_t PixelsSize() const { return pixels.size(); }
+};
+
+///// Test Fixture (Fx), contains SetUp, TearDown, and shared variables ///////
+class LedOutputsFx : public ::testing::Test {
+  protected:
+    // 1,030 LEDs on 4 outputs: 258, 258, 258 and 256
+    using Geometry =
+        MatrixGeometry<64, 16, 0, 6, LAYOUT_COLUMNS_SERPENTINE, 4>;
+
+    std::vector<int> showOrder;
+    LedOutputs<Geometry, MockBus> outputs{
+        [&](const int output, const uint16_t numLEDs) {
+            return std::make_unique<MockBus>(output, numLEDs, &showOrder);
+        }};
+
+    // a color that identifies the chain position it was written to
+    static MockColor ColorFor(const int chainPos) {
+        return {(uint8_t)(chainPos >> 8), (uint8_t)chainPos, 0xA5};
+    }
+};
+
+///// Individual tests (all are member functions of the fixture) //////////////
+TEST_F(LedOutputsFx, SegmentsCoverTheChain) {
+    EXPECT_EQ(Geometry::TOTAL_LEDS, 1030);
+    int total = 0;
+    for (int i = 0; i < Geometry::NUM_OUTPUTS; ++i) {
+        EXPECT_EQ(outputs.GetBus(i).pixels.size() / 3,
+                  (size_t)Geometry::SegmentLength(i));
+        total += Geometry::SegmentLength(i);
+    }
+    EXPECT_EQ(total, Geometry::TOTAL_LEDS);
+    EXPECT_EQ(Geometry::SegmentLength(3), 256);
+}
+
+TEST_F(LedOutputsFx, OutputsSendTheChainInOrderAsGRB) {
+    for (int pos = 0; pos < Geometry::TOTAL_LEDS; ++pos) {
+        outputs.SetPixelColor(pos, ColorFor(pos));
+    }
+    outputs.Show();
+
+    // concatenating what each output sent must give back the whole chain
+    int pos = 0;
+    for (int i = 0; i < Geometry::NUM_OUTPUTS; ++i) {
+        const auto& sent = outputs.GetBus(i).sent;
+        for (size_t byte = 0; byte < sent.size(); byte += 3, ++pos) {
+            const MockColor c = ColorFor(pos);
+            EXPECT_EQ(sent[byte], c.G);
+            EXPECT_EQ(sent[byte + 1], c.R);
+            EXPECT_EQ(sent[byte + 2], c.B);
+        }
+    }
+    EXPECT_EQ(pos, Geometry::TOTAL_LEDS);
+}
+
+TEST_F(LedOutputsFx, ReadsBackWhatWasWritten) {
+    outputs.SetPixelColor(777, ColorFor(777));
+    const MockColor c = outputs.GetPixelColor(777);
+    EXPECT_EQ(c.R, ColorFor(777).R);
+    EXPECT_EQ(c.G, ColorFor(777).G);
+    EXPECT_EQ(c.B, ColorFor(777).B);
+}
+
+TEST_F(LedOutputsFx, EveryOutputIsStartedEachFrame) {
+    outputs.Show();
+    EXPECT_EQ(showOrder, (std::vector<int>{0, 1, 2, 3}));
+}
+
+TEST_F(LedOutputsFx, ParallelOutputsFitAFrameAt30FPS) {
+    // a single 1,030 LED chain takes 1,030 x 30us + the 300us reset, which
+    // doesn't leave any time to draw at 30 FPS. Split 4 ways, the longest
+    // segment is 258 LEDs.
+    using Single = LedOutputs<MatrixGeometry<64, 16, 0, 6>, MockBus>;
+    EXPECT_EQ(Single::FrameUs(), 31200u);
+    EXPECT_EQ(decltype(outputs)::FrameUs(), 8040u);
+
+    // the CardClock 2: 17 x 11 + 3 rings of 12 on one output
+    using CardClock2 = LedOutputs<MatrixGeometry<17, 11, 3>, MockBus>;
+    EXPECT_EQ(CardClock2::FrameUs(), 6990u);
+}
+
+TEST_F(LedOutputsFx, DiffFrameFindsTheChangedLEDs) {
+    std::vector<uint8_t> lastFrame;
+    for (int i = 0; i < Geometry::TOTAL_LEDS; i += 100) {
+        outputs.SetPixelColor(i, ColorFor(i));
+    }
+    EXPECT_EQ(outputs.DiffFrame(lastFrame, true), 11u);
+    EXPECT_EQ(outputs.DiffFrame(lastFrame, true), 0u);
+
+    // one LED on the first and last outputs
+    outputs.SetPixelColor(1, ColorFor(1));
+    outputs.SetPixelColor(Geometry::TOTAL_LEDS - 1, ColorFor(0));
+    EXPECT_EQ(outputs.DiffFrame(lastFrame, false), 1u);
+    EXPECT_EQ(outputs.DiffFrame(lastFrame, false), 0u);
+
+    // set back to what it was, which isn't a change
+    outputs.SetPixelColor(1, MockColor{0, 0, 0});
+    outputs.SetPixelColor(1, ColorFor(1));
+    EXPECT_EQ(outputs.DiffFrame(lastFrame, true), 0u);
+}
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include <life_board.hpp>  // the unit of code being tested
+
+///// Test Fixture (Fx), contains SetUp, TearDown, and shared variables ///////
+class LifeBoardFx : public ::testing::Test {
+  protected:
+    // the same size as the CardClock 2.0 matrix
+    LifeBoard<17, 11> board;
+
+    // Helper functions for tests to use, to reduce code duplication
+    void SetCells(const std::vector<std::pair<int, int>>& cells) {
+        for (const auto& cell : cells) {
+            board.Set(cell.first, cell.second, true);
+        }
+    }
+};
+
+///// Individual tests (all are member functions of the fixture) //////////////
+TEST_F(LifeBoardFx, EmptyBoardStaysEmpty) {
+    board.Step();
+    EXPECT_EQ(board.Population(), 0);
+}
+
+TEST_F(LifeBoardFx, BlockIsStable) {
+    SetCells({{4, 4}, {5, 4}, {4, 5}, {5, 5}});
+    const auto before = board;
+    board.Step();
+    EXPECT_TRUE(board == before);
+}
+
+TEST_F(LifeBoardFx, BlinkerOscillates) {
+    SetCells({{7, 5}, {8, 5}, {9, 5}});
+    board.Step();
+    EXPECT_EQ(board.Population(), 3);
+    EXPECT_TRUE(board.Get(8, 4));
+    EXPECT_TRUE(board.Get(8, 5));
+    EXPECT_TRUE(board.Get(8, 6));
+    EXPECT_FALSE(board.Get(7, 5));
+
+    board.Step();
+    EXPECT_TRUE(board.Get(7, 5));
+    EXPECT_TRUE(board.Get(9, 5));
+    EXPECT_FALSE(board.Get(8, 4));
+}
+
+TEST_F(LifeBoardFx, BlinkerWrapsAroundTheEdges) {
+    // a vertical blinker in the first column becomes a horizontal one that
+    // spans the last, first and second columns
+    SetCells({{0, 0}, {0, 1}, {0, 10}});
+    board.Step();
+    EXPECT_EQ(board.Population(), 3);
+    EXPECT_TRUE(board.Get(16, 0));
+    EXPECT_TRUE(board.Get(0, 0));
+    EXPECT_TRUE(board.Get(1, 0));
+    EXPECT_EQ(board.GetRow(0)[0] & ~decltype(board)::LAST_WORD_MASK, 0u);
+}
+
+TEST_F(LifeBoardFx, GliderReturnsShiftedAfterFourGenerations) {
+    SetCells({{1, 0}, {2, 1}, {0, 2}, {1, 2}, {2, 2}});
+    for (int i = 0; i < 4; ++i) {
+        board.Step();
+    }
+
+    LifeBoard<17, 11> expected;
+    for (const auto& cell : std::vector<std::pair<int, int>>{
+             {2, 1}, {3, 2}, {1, 3}, {2, 3}, {3, 3}}) {
+        expected.Set(cell.first, cell.second, true);
+    }
+    EXPECT_TRUE(board == expected);
+}
+
+TEST_F(LifeBoardFx, WideRowsWrapAcrossWords) {
+    // the 64x16 panel needs two words per row. A blinker on the word
+    // boundary and one on the wrap-around both have to oscillate
+    LifeBoard<64, 16> wide;
+    for (const int x : {31, 32, 33, 63, 0, 1}) {
+        wide.Set(x, 5, true);
+    }
+    wide.Step();
+    EXPECT_EQ(wide.Population(), 6);
+    for (const int x : {32, 0}) {
+        EXPECT_TRUE(wide.Get(x, 4));
+        EXPECT_TRUE(wide.Get(x, 5));
+        EXPECT_TRUE(wide.Get(x, 6));
+    }
+    wide.Step();
+    for (const int x : {31, 32, 33, 63, 0, 1}) {
+        EXPECT_TRUE(wide.Get(x, 5));
+    }
+    EXPECT_EQ(wide.Population(), 6);
+}
+
+TEST_F(LifeBoardFx, GliderCrossesTheWordBoundary) {
+    LifeBoard<40, 8> wide;
+    for (const auto& cell : std::vector<std::pair<int, int>>{
+             {30, 0}, {31, 1}, {29, 2}, {30, 2}, {31, 2}}) {
+        wide.Set(cell.first, cell.second, true);
+    }
+    for (int i = 0; i < 4; ++i) {
+        wide.Step();
+    }
+
+    LifeBoard<40, 8> expected;
+    for (const auto& cell : std::vector<std::pair<int, int>>{
+             {31, 1}, {32, 2}, {30, 3}, {31, 3}, {32, 3}}) {
+        expected.Set(cell.first, cell.second, true);
+    }
+    EXPECT_TRUE(wide == expected);
+}
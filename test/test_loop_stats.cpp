@@ -0,0 +1,32 @@
+#include <gtest/gtest.h>
+
+#include <loop_stats.hpp>  // the unit of code being tested
+
+///// Test Fixture (Fx), contains SetUp, TearDown, and shared variables ///////
+class LoopStatsFx : public ::testing::Test {
+  protected:
+    LoopStats stats;
+};
+
+///// Individual tests (all are member functions of the fixture) //////////////
+TEST_F(LoopStatsFx, SpinningIsAllBusy) {
+    for (int i = 0; i < 1000; ++i) {
+        stats.AddIteration(50, 0);
+    }
+    EXPECT_FLOAT_EQ(stats.GetIterationsPerSecond(), 20000);
+    EXPECT_FLOAT_EQ(stats.GetBusyPercent(), 100);
+}
+
+TEST_F(LoopStatsFx, WaitingForTicksIsMostlyIdle) {
+    // a frame for the tick, a probe, then waiting for the next tick
+    for (int i = 0; i < 10; ++i) {
+        stats.AddIteration(8000, 25000);
+        stats.AddIteration(7000, 960000);
+    }
+    EXPECT_FLOAT_EQ(stats.GetIterationsPerSecond(), 2);
+    EXPECT_FLOAT_EQ(stats.GetBusyPercent(), 1.5f);
+
+    stats.Reset();
+    EXPECT_EQ(stats.GetIterations(), 0u);
+    EXPECT_FLOAT_EQ(stats.GetBusyPercent(), 0);
+}
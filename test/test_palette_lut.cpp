@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+
+#include <palette_lut.hpp>  // the unit of code being tested
+
+///// Test Fixture (Fx), contains SetUp, TearDown, and shared variables ///////
+class PaletteLutFx : public ::testing::Test {
+  protected:
+    struct Color {
+        uint8_t R{0}, G{0}, B{0};
+        Color() {}
+        Color(uint8_t r, uint8_t g, uint8_t b) : R(r), G(g), B(b) {}
+    };
+    using Palette = BasicPalette<Color>;
+
+    // Helper functions for tests to use, to reduce code duplication
+
+    // black, white and red first, blue last, and 0x102030 for all the rest
+    static Palette::Stops MakeStops() {
+        Palette::Stops stops;
+        stops.fill(0x102030);
+        stops[0] = 0x000000;
+        stops[1] = 0xFFFFFF;
+        stops[2] = 0xFF0000;
+        stops[15] = 0x0000FF;
+        return stops;
+    }
+
+    static void ExpectColor(const Color& color,
+                            const uint8_t r,
+                            const uint8_t g,
+                            const uint8_t b) {
+        EXPECT_EQ(color.R, r);
+        EXPECT_EQ(color.G, g);
+        EXPECT_EQ(color.B, b);
+    }
+
+    // NeoPixelBus' RgbColor(HslColor), which the rainbow used to be built
+    // with, for any saturation and lightness
+    static Color FromHsl(const float h, const float s, const float l) {
+        auto calc = [](const float p, const float q, float t) {
+            if (t < 0.0f) {
+                t += 1.0f;
+            }
+            if (t > 1.0f) {
+                t -= 1.0f;
+            }
+            if (t < 1.0f / 6.0f) {
+                return p + (q - p) * 6.0f * t;
+            }
+            if (t < 0.5f) {
+                return q;
+            }
+            if (t < 2.0f / 3.0f) {
+                return p + ((q - p) * (2.0f / 3.0f - t) * 6.0f);
+            }
+            return p;
+        };
+        const float q = l < 0.5f ? l * (1.0f + s) : l + s - (l * s);
+        const float p = 2.0f * l - q;
+        return Color((uint8_t)(calc(p, q, h + 1.0f / 3.0f) * 255),
+                     (uint8_t)(calc(p, q, h) * 255),
+                     (uint8_t)(calc(p, q, h - 1.0f / 3.0f) * 255));
+    }
+};
+
+///// Individual tests (all are member functions of the fixture) //////////////
+TEST_F(PaletteLutFx, StopsLandOnEverySixteenthEntry) {
+    const Palette::Lut lut = Palette::Expand(MakeStops());
+    ExpectColor(lut[0], 0x00, 0x00, 0x00);
+    ExpectColor(lut[16], 0xFF, 0xFF, 0xFF);
+    ExpectColor(lut[32], 0xFF, 0x00, 0x00);
+    ExpectColor(lut[48], 0x10, 0x20, 0x30);
+    ExpectColor(lut[240], 0x00, 0x00, 0xFF);
+}
+
+TEST_F(PaletteLutFx, EntriesBetweenStopsInterpolate) {
+    const Palette::Lut lut = Palette::Expand(MakeStops());
+    // halfway from black to white, then a quarter of the way to red
+    ExpectColor(lut[8], 0x7F, 0x7F, 0x7F);
+    ExpectColor(lut[20], 0xFF, 0xBF, 0xBF);
+    for (size_t i = 1; i < 16; ++i) {
+        EXPECT_GT(lut[i].R, lut[i - 1].R);
+    }
+}
+
+TEST_F(PaletteLutFx, LastStopWrapsBackToTheFirst) {
+    const Palette::Lut lut = Palette::Expand(MakeStops());
+    // blue fades out towards black across entries 240-255
+    ExpectColor(lut[248], 0x00, 0x00, 0x7F);
+    ExpectColor(lut[255], 0x00, 0x00, 0x0F);
+    for (size_t i = 241; i < 256; ++i) {
+        EXPECT_LT(lut[i].B, lut[i - 1].B);
+    }
+}
+
+TEST_F(PaletteLutFx, SamplesBetweenEntriesInEightDotEight) {
+    Palette::Lut lut;
+    lut.fill(Color());
+    lut[10] = Color(0, 100, 200);
+    lut[11] = Color(200, 100, 0);
+    lut[255] = Color(255, 255, 255);
+
+    ExpectColor(Palette::Sample(lut, 10 << 8), 0, 100, 200);
+    ExpectColor(Palette::Sample(lut, 11 << 8), 200, 100, 0);
+    ExpectColor(Palette::Sample(lut, (10 << 8) + 0x40), 50, 100, 150);
+    ExpectColor(Palette::Sample(lut, (10 << 8) + 0x80), 100, 100, 100);
+
+    // between the last entry and the first
+    ExpectColor(Palette::Sample(lut, (255 << 8) + 0x80), 127, 127, 127);
+}
+
+TEST_F(PaletteLutFx, BlendsFromOneTableToTheOther) {
+    Palette::Lut from, to, lut;
+    from.fill(Color(0, 255, 100));
+    to.fill(Color(255, 0, 100));
+
+    Palette::Blend(from, to, 0, lut);
+    for (const Color& color : lut) {
+        ExpectColor(color, 0, 255, 100);
+    }
+
+    // 255 is almost all |to|, within one step
+    Palette::Blend(from, to, 255, lut);
+    for (const Color& color : lut) {
+        ExpectColor(color, 254, 0, 100);
+    }
+}
+
+TEST_F(PaletteLutFx, RainbowMatchesTheHslWheel) {
+    const Palette::Lut lut = Palette::Rainbow();
+    for (size_t i = 0; i < Palette::LUT_SIZE; ++i) {
+        const Color hsl = FromHsl(i / 255.0f, 1.0f, 0.5f);
+        ExpectColor(lut[i], hsl.R, hsl.G, hsl.B);
+    }
+    ExpectColor(lut[0], 255, 0, 0);
+    ExpectColor(lut[85], 0, 255, 0);
+    ExpectColor(lut[170], 0, 0, 255);
+}
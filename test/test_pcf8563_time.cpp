@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+
+#include <pcf8563_time.hpp>  // the unit of code being tested
+
+///// Test Fixture (Fx), contains SetUp, TearDown, and shared variables ///////
+class Pcf8563TimeFx : public ::testing::Test {
+  protected:
+    Pcf8563Time time;
+
+    // 23:59:58 on Tuesday 2024-12-31, as the registers hold it
+    uint8_t regs[Pcf8563Time::NUM_REGISTERS] = {0x58, 0x59, 0x23, 0x31,
+                                                0x02, 0x12, 0x24};
+};
+
+///// Individual tests (all are member functions of the fixture) //////////////
+TEST_F(Pcf8563TimeFx, DecodesBcdRegisters) {
+    ASSERT_TRUE(Pcf8563Time::Decode(regs, time));
+    EXPECT_EQ(time.hour, 23);
+    EXPECT_EQ(time.minute, 59);
+    EXPECT_EQ(time.second, 58);
+    EXPECT_EQ(time.day, 31);
+    EXPECT_EQ(time.weekday, 2);
+    EXPECT_EQ(time.month, 12);
+    EXPECT_EQ(time.year, 2024);
+    EXPECT_FALSE(time.voltageLow);
+}
+
+TEST_F(Pcf8563TimeFx, RejectsInvalidRegisters) {
+    regs[2] = 0x33;  // what the RTC reports before it's started
+    EXPECT_FALSE(Pcf8563Time::Decode(regs, time));
+    regs[2] = 0x23;
+    regs[0] = 0x5A;  // not BCD
+    EXPECT_FALSE(Pcf8563Time::Decode(regs, time));
+    regs[0] = 0x58;
+    regs[5] = 0x13;  // month 13
+    EXPECT_FALSE(Pcf8563Time::Decode(regs, time));
+    EXPECT_EQ(time.hour, 0);  // untouched
+}
+
+TEST_F(Pcf8563TimeFx, ReportsVoltageLow) {
+    regs[0] |= 0x80;
+    ASSERT_TRUE(Pcf8563Time::Decode(regs, time));
+    EXPECT_TRUE(time.voltageLow);
+    EXPECT_EQ(time.second, 58);
+}
+
+TEST_F(Pcf8563TimeFx, AdvancesAcrossMidnight) {
+    ASSERT_TRUE(Pcf8563Time::Decode(regs, time));
+    time.AdvanceSeconds(3);
+    EXPECT_EQ(time.hour, 0);
+    EXPECT_EQ(time.minute, 0);
+    EXPECT_EQ(time.second, 1);
+    EXPECT_EQ(time.year, 2025);
+    EXPECT_EQ(time.month, 1);
+    EXPECT_EQ(time.day, 1);
+    EXPECT_EQ(time.weekday, 3);  // Wednesday
+
+    time.AdvanceSeconds(3600 + 61);
+    EXPECT_EQ(time.hour, 1);
+    EXPECT_EQ(time.minute, 1);
+    EXPECT_EQ(time.second, 2);
+}
+
+TEST_F(Pcf8563TimeFx, EpochRoundTrips) {
+    ASSERT_TRUE(Pcf8563Time::Decode(regs, time));
+    EXPECT_EQ(time.Epoch(), 1735689598);  // 2024-12-31 23:59:58
+
+    Pcf8563Time leapDay;
+    leapDay.SetEpoch(1709208000);  // 2024-02-29 12:00:00, a Thursday
+    EXPECT_EQ(leapDay.month, 2);
+    EXPECT_EQ(leapDay.day, 29);
+    EXPECT_EQ(leapDay.weekday, 4);
+    EXPECT_EQ(leapDay.hour, 12);
+    EXPECT_EQ(leapDay.Epoch(), 1709208000);
+}
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include <pixel_math.hpp>  // the unit of code being tested
+
+///// Test Fixture (Fx), contains SetUp, TearDown, and shared variables ///////
+class PixelMathFx : public ::testing::Test {
+  protected:
+    // Helper functions for tests to use, to reduce code duplication
+    static uint8_t ScaleTimes(uint8_t channel,
+                              const float amount,
+                              const size_t numTimes) {
+        const uint32_t once = PixelMath::RepeatedScale(amount, 1);
+        for (size_t i = 0; i < numTimes; ++i) {
+            channel = PixelMath::ScaleChannel(channel, once);
+        }
+        return channel;
+    }
+};
+
+///// Individual tests (all are member functions of the fixture) //////////////
+TEST_F(PixelMathFx, UnityLeavesChannelsAlone) {
+    for (int c = 0; c < 256; ++c) {
+        EXPECT_EQ(PixelMath::ScaleChannel(c, PixelMath::UNITY), c);
+    }
+}
+
+TEST_F(PixelMathFx, RepeatedScaleDarkensEveryTime) {
+    // darkening 4 times in one pass is about as dark as 4 passes
+    const uint8_t once = PixelMath::ScaleChannel(
+        200, PixelMath::RepeatedScale(0.5f, 1));
+    const uint8_t fourTimes = PixelMath::ScaleChannel(
+        200, PixelMath::RepeatedScale(0.5f, 4));
+    EXPECT_EQ(once, 100);
+    EXPECT_EQ(fourTimes, 12);
+    EXPECT_NEAR(fourTimes, ScaleTimes(200, 0.5f, 4), 1);
+
+    EXPECT_NEAR(PixelMath::ScaleChannel(255, PixelMath::RepeatedScale(0.85f, 3)),
+                ScaleTimes(255, 0.85f, 3), 2);
+    EXPECT_EQ(PixelMath::RepeatedScale(0.85f, 0), PixelMath::UNITY);
+}
+
+TEST_F(PixelMathFx, GainAboveUnitySaturates) {
+    const uint32_t oneAndAHalf = PixelMath::UNITY * 3 / 2;
+    EXPECT_EQ(PixelMath::ScaleChannel(100, oneAndAHalf), 150);
+    EXPECT_EQ(PixelMath::ScaleChannel(200, oneAndAHalf), 255);
+    EXPECT_EQ(PixelMath::ScaleChannel(255, 0xFFFFFFFF), 255);
+}
+
+TEST_F(PixelMathFx, FrameScaleMultipliesTheGain) {
+    const uint32_t half = PixelMath::UNITY / 2;
+    const uint32_t oneAndAHalf = PixelMath::UNITY * 3 / 2;
+    for (const int channel : {0, 1, 100, 200, 255}) {
+        EXPECT_EQ(
+            PixelMath::ScaleChannel(channel, oneAndAHalf, PixelMath::UNITY),
+            PixelMath::ScaleChannel(channel, oneAndAHalf));
+    }
+    EXPECT_EQ(PixelMath::ScaleChannel(200, oneAndAHalf, half), 150);
+    EXPECT_EQ(PixelMath::ScaleChannel(255, 0xFFFFFFFF, PixelMath::UNITY), 255);
+    // rounded once, where scaling twice would lose the odd bit
+    EXPECT_EQ(PixelMath::ScaleChannel(3, half, oneAndAHalf), 2);
+    EXPECT_EQ(PixelMath::ScaleChannel(PixelMath::ScaleChannel(3, half),
+                                      oneAndAHalf),
+              1);
+}
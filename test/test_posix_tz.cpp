@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+
+#include <posix_tz.hpp>  // the unit of code being tested
+
+///// Test Fixture (Fx), contains SetUp, TearDown, and shared variables ///////
+class PosixTzFx : public ::testing::Test {
+  protected:
+    PosixTz tz;
+
+    // 2024-03-31 01:00 and 2024-10-27 01:00 UTC, when the UK's clocks change
+    const time_t UK_SPRING = 1711846800;
+    const time_t UK_AUTUMN = 1729990800;
+};
+
+///// Individual tests (all are member functions of the fixture) //////////////
+TEST_F(PosixTzFx, ConvertsCalendarDates) {
+    EXPECT_EQ(PosixTz::DaysFromCivil(1970, 1, 1), 0);
+    EXPECT_EQ(PosixTz::DaysFromCivil(2024, 3, 31) * PosixTz::DAY_S + 3600,
+              UK_SPRING);
+    EXPECT_EQ(PosixTz::YearOf(UK_SPRING), 2024);
+    EXPECT_EQ(PosixTz::YearOf(PosixTz::DaysFromCivil(2025, 1, 1) *
+                                  PosixTz::DAY_S - 1),
+              2024);
+}
+
+TEST_F(PosixTzFx, FixedOffsets) {
+    ASSERT_TRUE(tz.Parse("<+0545>-5:45"));  // Kathmandu
+    EXPECT_EQ(tz.ToLocal(UK_SPRING), UK_SPRING + 5 * 3600 + 45 * 60);
+    EXPECT_FALSE(tz.IsDst());
+
+    ASSERT_TRUE(tz.Parse("HST10"));
+    EXPECT_EQ(tz.ToLocal(UK_SPRING), UK_SPRING - 10 * 3600);
+}
+
+TEST_F(PosixTzFx, ChangesAtTheTransitions) {
+    ASSERT_TRUE(tz.Parse("GMT0BST,M3.5.0/1,M10.5.0"));
+    EXPECT_EQ(tz.ToLocal(UK_SPRING - 1), UK_SPRING - 1);
+    EXPECT_EQ(tz.ToLocal(UK_SPRING), UK_SPRING + 3600);
+    EXPECT_TRUE(tz.IsDst());
+    EXPECT_EQ(tz.GetNextTransition(), UK_AUTUMN);
+    EXPECT_EQ(tz.ToLocal(UK_AUTUMN - 1), UK_AUTUMN - 1 + 3600);
+    EXPECT_EQ(tz.ToLocal(UK_AUTUMN), UK_AUTUMN);
+    EXPECT_FALSE(tz.IsDst());
+}
+
+TEST_F(PosixTzFx, SouthernHemisphere) {
+    // Sydney: daylight time from 2024-10-06 02:00 (2024-10-05 16:00 UTC)
+    // until 2024-04-07 03:00 daylight time (2024-04-06 16:00 UTC)
+    ASSERT_TRUE(tz.Parse("AEST-10AEDT,M10.1.0,M4.1.0/3"));
+    const time_t january = 1704067200;  // 2024-01-01 00:00 UTC
+    EXPECT_EQ(tz.ToLocal(january), january + 11 * 3600);
+    EXPECT_EQ(tz.GetNextTransition(), 1712419200);
+    EXPECT_EQ(tz.ToLocal(1712419200), 1712419200 + 10 * 3600);
+    EXPECT_EQ(tz.GetNextTransition(), 1728144000);
+}
+
+TEST_F(PosixTzFx, RulesAfterMidnight) {
+    // Israel: the Friday before the last Sunday of March, at 02:00, written
+    // as 26:00 on the Thursday. In 2024 that's 2024-03-29 00:00 UTC.
+    ASSERT_TRUE(tz.Parse("IST-2IDT,M3.4.4/26,M10.5.0"));
+    EXPECT_EQ(tz.ToLocal(1711670400 - 1), 1711670400 - 1 + 2 * 3600);
+    EXPECT_EQ(tz.ToLocal(1711670400), 1711670400 + 3 * 3600);
+}
+
+TEST_F(PosixTzFx, RejectsMalformedStrings) {
+    EXPECT_FALSE(tz.Parse(""));
+    EXPECT_FALSE(tz.Parse("CET"));
+    EXPECT_FALSE(tz.Parse("CET-1CEST,M3.5.0"));
+    EXPECT_FALSE(tz.Parse("CET-1CEST,M13.5.0,M10.5.0/3"));
+    EXPECT_EQ(tz.ToLocal(UK_SPRING), UK_SPRING);  // UTC
+}
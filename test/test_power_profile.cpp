@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+
+#include <power_profile.hpp>  // the unit of code being tested
+
+///// Test Fixture (Fx), contains SetUp, TearDown, and shared variables ///////
+class ProfileScheduleFx : public ::testing::Test {
+  protected:
+    ProfileSchedule schedule;
+    PowerProfile day;
+    PowerProfile night{5, 2, 0, true, 80};
+
+    const int64_t MIDNIGHT = 1735689600;  // 2025-01-01 00:00
+
+    void SetUp() override {
+        schedule.Add(22 * 60, night);
+        schedule.Add(7 * 60, day);
+    }
+
+    // Helper functions for tests to use, to reduce code duplication
+    static int64_t At(const int64_t day, const int hour, const int minute) {
+        return day + hour * 3600 + minute * 60;
+    }
+};
+
+///// Individual tests (all are member functions of the fixture) //////////////
+TEST_F(ProfileScheduleFx, NothingActiveUntilUpdated) {
+    EXPECT_EQ(schedule.Active(), nullptr);
+    ProfileSchedule empty;
+    EXPECT_FALSE(empty.Update(MIDNIGHT));
+    EXPECT_EQ(empty.Active(), nullptr);
+}
+
+TEST_F(ProfileScheduleFx, NightWrapsAroundMidnight) {
+    EXPECT_TRUE(schedule.Update(At(MIDNIGHT, 3, 0)));
+    EXPECT_EQ(*schedule.Active(), night);
+    EXPECT_EQ(schedule.GetNextSwitch(), At(MIDNIGHT, 7, 0));
+
+    EXPECT_TRUE(schedule.Update(At(MIDNIGHT, 12, 0)));
+    EXPECT_EQ(*schedule.Active(), day);
+    EXPECT_EQ(schedule.GetNextSwitch(), At(MIDNIGHT, 22, 0));
+
+    EXPECT_TRUE(schedule.Update(At(MIDNIGHT, 23, 0)));
+    EXPECT_EQ(*schedule.Active(), night);
+    EXPECT_EQ(schedule.GetNextSwitch(), At(MIDNIGHT + 86400, 7, 0));
+}
+
+TEST_F(ProfileScheduleFx, OnlyChangesAtTheSwitch) {
+    schedule.Update(At(MIDNIGHT, 7, 0));
+    EXPECT_FALSE(schedule.Update(At(MIDNIGHT, 21, 59) + 59));
+    EXPECT_TRUE(schedule.Update(At(MIDNIGHT, 22, 0)));
+    EXPECT_FALSE(schedule.Update(At(MIDNIGHT + 86400, 6, 59)));
+    EXPECT_TRUE(schedule.Update(At(MIDNIGHT + 86400, 7, 0)));
+}
+
+TEST_F(ProfileScheduleFx, ClockSetBackwards) {
+    schedule.Update(At(MIDNIGHT, 12, 0));
+    EXPECT_TRUE(schedule.Update(At(MIDNIGHT, 6, 0)));
+    EXPECT_EQ(*schedule.Active(), night);
+}
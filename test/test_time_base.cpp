@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include <time_base.hpp>  // the unit of code being tested
+
+///// Test Fixture (Fx), contains SetUp, TearDown, and shared variables ///////
+class TimeBaseFx : public ::testing::Test {
+  protected:
+    TimeBase timeBase;
+    uint32_t edgeUs{123456};
+
+    // Helper functions for tests to use, to reduce code duplication
+
+    // edges from an RTC whose second lasts |periodUs| micros()
+    void Edges(const int count, const uint32_t periodUs) {
+        for (int i = 0; i < count; ++i) {
+            edgeUs += periodUs;
+            timeBase.OnEdge(edgeUs);
+        }
+    }
+};
+
+///// Individual tests (all are member functions of the fixture) //////////////
+TEST_F(TimeBaseFx, LearnsHowFastMicrosRuns) {
+    timeBase.OnEdge(edgeUs);
+    Edges(60, 1000100);  // micros() is 100ppm fast
+    EXPECT_NEAR(timeBase.GetFrequencyErrorPpm(), 100, 1);
+    EXPECT_TRUE(timeBase.IsLocked());
+
+    // half way through a second, it's half a second in
+    EXPECT_NEAR(timeBase.MicrosIntoSecond(edgeUs + 500050), 500000, 100);
+}
+
+TEST_F(TimeBaseFx, IsMonotonicAndNeverWrapsBeforeTheNextEdge) {
+    timeBase.OnEdge(edgeUs);
+    Edges(5, 1000000);
+    uint64_t last = 0;
+    for (uint32_t us = 0; us < 3000000; us += 997) {
+        const uint64_t now = timeBase.Micros(edgeUs + us);
+        EXPECT_GE(now, last);
+        last = now;
+    }
+    // the next edge is late, so the second holds at its end
+    EXPECT_EQ(timeBase.MicrosIntoSecond(edgeUs + 1500000), 999999u);
+}
+
+TEST_F(TimeBaseFx, SlewsOutJitterInsteadOfJumping) {
+    timeBase.OnEdge(edgeUs);
+    Edges(10, 1000000);
+
+    // after an edge 3ms late, the time carries on from where it was and
+    // the next second is a little shorter to catch up
+    edgeUs += 1003000;
+    timeBase.OnEdge(edgeUs);
+    EXPECT_EQ(timeBase.GetPhaseErrorUs(), -3000);
+    const uint64_t atEdge = timeBase.Micros(edgeUs);
+    const uint64_t secondLater = timeBase.Micros(edgeUs + 1000000);
+    EXPECT_LT(secondLater - atEdge, 1000000u);
+    EXPECT_GT(secondLater - atEdge, 1000000u - TimeBase::MAX_SLEW_US);
+
+    Edges(10, 1000000);
+    EXPECT_LT(abs(timeBase.GetPhaseErrorUs()), 1000);
+}
+
+TEST_F(TimeBaseFx, MissedEdgesStillCountAsSeconds) {
+    timeBase.OnEdge(edgeUs);
+    Edges(5, 1000000);
+    Edges(1, 3000000);  // two edges were missed
+    EXPECT_EQ(timeBase.GetEdges(), 9u);
+    EXPECT_NEAR(timeBase.GetFrequencyErrorPpm(), 0, 1);
+}
+
+TEST_F(TimeBaseFx, KnowsWhenTheNextEdgeIsDue) {
+    timeBase.OnEdge(edgeUs);
+    EXPECT_EQ(timeBase.MicrosUntilNextEdge(edgeUs + 1000), 0u);
+
+    Edges(20, 1000100);
+    EXPECT_NEAR(timeBase.MicrosUntilNextEdge(edgeUs + 250000), 750100, 10);
+    // late, or already past it
+    EXPECT_EQ(timeBase.MicrosUntilNextEdge(edgeUs + 1200000), 0u);
+}
+
+TEST_F(TimeBaseFx, IgnoresPeriodsFarFromASecond) {
+    timeBase.OnEdge(edgeUs);
+    Edges(20, 1000000);
+
+    // a second 10% long, e.g. the RTC being set, isn't a frequency error
+    Edges(1, 1100000);
+    EXPECT_NEAR(timeBase.GetFrequencyErrorPpm(), 0, 1);
+    Edges(1, 1010000);  // 1%, which is
+    EXPECT_GT(timeBase.GetFrequencyErrorPpm(), 1000);
+}
+
+TEST_F(TimeBaseFx, StepsLargeErrorsEitherWay) {
+    timeBase.OnEdge(edgeUs);
+    Edges(10, 1000000);
+
+    // an edge 300ms late means the time ran ahead, and it steps back to the
+    // start of the new second rather than taking a minute to slew it out
+    edgeUs += 1300000;
+    timeBase.OnEdge(edgeUs);
+    EXPECT_EQ(timeBase.GetPhaseErrorUs(), 0);
+    EXPECT_EQ(timeBase.Micros(edgeUs), 11000000u);
+    EXPECT_EQ(timeBase.MicrosIntoSecond(edgeUs + 250000), 250000u);
+
+    // and 300ms early, that it fell behind
+    edgeUs += 700000;
+    timeBase.OnEdge(edgeUs);
+    EXPECT_EQ(timeBase.GetPhaseErrorUs(), 0);
+    EXPECT_EQ(timeBase.Micros(edgeUs), 12000000u);
+}
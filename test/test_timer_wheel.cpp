@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <timer_wheel.hpp>  // the unit of code being tested
+
+///// Test Fixture (Fx), contains SetUp, TearDown, and shared variables ///////
+class TimerWheelFx : public ::testing::Test {
+  protected:
+    TimerWheel wheel;
+    uint32_t nowMs{0xFFFFF000};  // close to millis() wrapping around
+    std::vector<std::pair<int, uint32_t>> fired;  // which, and when
+
+    virtual void SetUp() { wheel.Update(nowMs); }
+
+    // Helper functions for tests to use, to reduce code duplication
+    TimerWheel::Id Add(const int name) {
+        return wheel.Add([this, name] { fired.push_back({name, elapsed}); });
+    }
+
+    // a ms at a time, like a busy loop
+    void Run(const uint32_t ms) {
+        for (uint32_t i = 0; i < ms; ++i) {
+            ++elapsed;
+            wheel.Update(++nowMs);
+        }
+    }
+
+    uint32_t elapsed{0};
+};
+
+///// Individual tests (all are member functions of the fixture) //////////////
+TEST_F(TimerWheelFx, OneShotsFireOnTimeAtEveryLevel) {
+    const uint32_t delays[] = {1, 63, 64, 65, 1000, 4095, 4096, 300000};
+    for (int i = 0; i < 8; ++i) {
+        wheel.Start(Add(i), delays[i]);
+    }
+    Run(300001);
+    ASSERT_EQ(fired.size(), 8u);
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_EQ(fired[i].first, i);
+        EXPECT_EQ(fired[i].second, delays[i]);
+    }
+}
+
+TEST_F(TimerWheelFx, PeriodicTimersKeepFiring) {
+    wheel.StartPeriodic(Add(0), 50);
+    Run(1000);
+    ASSERT_EQ(fired.size(), 20u);
+    EXPECT_EQ(fired.back().second, 1000u);
+}
+
+TEST_F(TimerWheelFx, StallsSkipPeriodsAndCatchUpInOneUpdate) {
+    wheel.StartPeriodic(Add(0), 50);
+    wheel.Start(Add(1), 5000);
+    nowMs += 7000;
+    elapsed += 7000;
+    wheel.Update(nowMs);
+    // the periodic one fires once, rather than 140 times
+    EXPECT_EQ(fired.size(), 2u);
+    Run(50);
+    EXPECT_EQ(fired.size(), 3u);
+}
+
+TEST_F(TimerWheelFx, StoppedAndRestartedTimers) {
+    const auto timeout = Add(0);
+    wheel.Start(timeout, 100);
+    Run(90);
+    wheel.Start(timeout, 100);  // e.g. a button was pressed
+    Run(90);
+    EXPECT_TRUE(fired.empty());
+    wheel.Stop(timeout);
+    EXPECT_FALSE(wheel.IsRunning(timeout));
+    Run(200);
+    EXPECT_TRUE(fired.empty());
+}
+
+TEST_F(TimerWheelFx, CallbacksCanStartAndRemoveTimers) {
+    const auto second = Add(1);
+    TimerWheel::Id first = TimerWheel::INVALID;
+    first = wheel.Add([&] {
+        wheel.Start(second, 10);
+        wheel.Remove(first);
+    });
+    wheel.StartPeriodic(first, 20);
+    Run(100);
+    ASSERT_EQ(fired.size(), 1u);
+    EXPECT_EQ(fired[0].second, 30u);
+}
+
+TEST_F(TimerWheelFx, KnowsHowLongUntilTheNextOne) {
+    EXPECT_EQ(wheel.MsUntilNext(), (uint32_t)TimerWheel::NONE);
+    wheel.Start(Add(0), 30);
+    EXPECT_EQ(wheel.MsUntilNext(), 30u);
+    // further out, it's when the timer moves down a level, which is sooner
+    wheel.Stop(0);
+    wheel.Start(0, 5000);
+    EXPECT_GT(wheel.MsUntilNext(), 0u);
+    EXPECT_LE(wheel.MsUntilNext(), 5000u);
+    Run(wheel.MsUntilNext());
+    EXPECT_LE(wheel.MsUntilNext(), 5000u - elapsed);
+}
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+
+#include <trail_buffer.hpp>  // the unit of code being tested
+
+///// Test Fixture (Fx), contains SetUp, TearDown, and shared variables ///////
+class TrailBufferFx : public ::testing::Test {
+  protected:
+    TrailBuffer<17, 11> trail;
+
+    // Helper functions for tests to use, to reduce code duplication
+    // a frame every |frameMs|, fading with |halfLifeMs| like ComposeLayer()
+    void Fade(const float frameMs, const uint16_t halfLifeMs) {
+        const uint32_t keep = trail.Keep(frameMs, halfLifeMs);
+        for (int pos = 0; pos < trail.LEDS; ++pos) {
+            trail.Fade(pos, keep);
+        }
+    }
+
+    uint8_t Max(const int channel) const {
+        uint8_t brightest = 0;
+        for (int pos = 0; pos < trail.LEDS; ++pos) {
+            brightest = std::max(brightest, trail.Get(pos, channel));
+        }
+        return brightest;
+    }
+};
+
+///// Individual tests (all are member functions of the fixture) //////////////
+TEST_F(TrailBufferFx, SplatOnAnLedCenterLandsOnThatLed) {
+    trail.Splat(4.5f, 2.5f, 200, 100, 50);
+    const int pos = 2 * 17 + 4;
+    EXPECT_EQ(trail.Get(pos, 0), 200);
+    EXPECT_EQ(trail.Get(pos, 1), 100);
+    EXPECT_EQ(trail.Get(pos, 2), 50);
+    EXPECT_EQ(trail.Get(pos + 1, 0), 0);
+    EXPECT_EQ(trail.Get(pos + 17, 0), 0);
+}
+
+TEST_F(TrailBufferFx, SplatBetweenLedsSharesTheColor) {
+    trail.Splat(5.0f, 2.5f, 200, 200, 200);
+    EXPECT_EQ(trail.Get(2 * 17 + 4, 0), 100);
+    EXPECT_EQ(trail.Get(2 * 17 + 5, 0), 100);
+}
+
+TEST_F(TrailBufferFx, StationaryParticleNeverOutshinesItsColor) {
+    // Snowfall's flakes and Starfield's stars are splatted every frame while
+    // their trail only fades a little in between
+    const float positions[][2] = {{4.5f, 2.5f}, {4.8f, 3.3f}};
+    for (const auto& at : positions) {
+        trail.Clear();
+        for (int frame = 0; frame < 200; ++frame) {
+            trail.Splat(at[0], at[1], 180, 90, 30);
+            Fade(20, 85);
+        }
+        trail.Splat(at[0], at[1], 180, 90, 30);
+        EXPECT_LE(Max(0), 180);
+        EXPECT_LE(Max(1), 90);
+        EXPECT_LE(Max(2), 30);
+    }
+    EXPECT_GE(Max(0), 180 / 4);  // the last one is shared by 4 LEDs
+}
+
+TEST_F(TrailBufferFx, TrailsHalveEveryHalfLife) {
+    trail.Set(3, 3, 200, 200, 200);
+    Fade(100, 100);
+    EXPECT_NEAR(trail.Get(3 * 17 + 3, 0), 100, 1);
+    for (int i = 0; i < 10; ++i) {
+        Fade(10, 100);
+    }
+    EXPECT_NEAR(trail.Get(3 * 17 + 3, 0), 50, 1);
+}
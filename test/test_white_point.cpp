@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+
+#include <white_point.hpp>  // the unit of code being tested
+
+///// Test Fixture (Fx), contains SetUp, TearDown, and shared variables ///////
+class WhitePointFx : public ::testing::Test {
+  protected:
+    static int Minute(const int hour, const int minute) {
+        return hour * 60 + minute;
+    }
+};
+
+///// Individual tests (all are member functions of the fixture) //////////////
+TEST_F(WhitePointFx, DaylightLeavesColorsAlone) {
+    const WhitePoint wp = WhitePoint::FromKelvin(WhitePoint::DAYLIGHT_K);
+    EXPECT_FLOAT_EQ(wp.r, 1.0f);
+    EXPECT_FLOAT_EQ(wp.g, 1.0f);
+    EXPECT_FLOAT_EQ(wp.b, 1.0f);
+}
+
+TEST_F(WhitePointFx, WarmWhiteCutsBlueMostThenGreen) {
+    const WhitePoint wp = WhitePoint::FromKelvin(2700);
+    EXPECT_FLOAT_EQ(wp.r, 1.0f);
+    EXPECT_LT(wp.g, 0.8f);
+    EXPECT_LT(wp.b, wp.g);
+    EXPECT_GT(wp.b, 0.0f);
+}
+
+TEST_F(WhitePointFx, WarmthFollowsTheTimeOfDay) {
+    EXPECT_FLOAT_EQ(WhitePoint::CircadianWarmth(Minute(12, 0), 0), 0.0f);
+    EXPECT_FLOAT_EQ(WhitePoint::CircadianWarmth(Minute(20, 0), 0), 0.5f);
+    EXPECT_FLOAT_EQ(WhitePoint::CircadianWarmth(Minute(23, 0), 0), 1.0f);
+    EXPECT_FLOAT_EQ(WhitePoint::CircadianWarmth(Minute(3, 0), 0), 1.0f);
+    EXPECT_FLOAT_EQ(WhitePoint::CircadianWarmth(Minute(7, 0), 0), 0.5f);
+}
+
+TEST_F(WhitePointFx, BrightRoomsGetHalfTheShift) {
+    EXPECT_FLOAT_EQ(WhitePoint::CircadianWarmth(Minute(23, 0), 1.0f), 0.5f);
+    EXPECT_FLOAT_EQ(WhitePoint::CircadianWarmth(Minute(23, 0), 0.125f), 0.75f);
+}